@@ -11,12 +11,17 @@
 #include "../parser/preprocessor/default.h"
 #include "../fileio/default.h"
 #include "../parser/sqf/sqf_parser.hpp"
+#include "../parser/sqf/sqf_precompiled.hpp"
 #if defined(SQF_SQC_SUPPORT)
 #include "../sqc/sqc_parser.h"
 #endif
 
 #include <tclap/CmdLine.h>
 
+#include <atomic>
+#include <thread>
+#include <sstream>
+
 #ifdef _WIN32
 #include <windows.h>
 #include <direct.h>
@@ -37,209 +42,215 @@
 #define CMDADD(TYPE, NAME, ...) TYPE NAME(__VA_ARGS__); cmd.add(NAME)
 
 
-void cli::handle_files()
+cli::prepared_file cli::prepare_file(const std::string& key, const file_generator& generator)
 {
-    for (auto& [key, generators] : m_files)
+    prepared_file file;
+    file.key = key;
+    try
     {
-        for (auto& generator : generators)
+        auto [path, contents] = generator();
+        file.path = path;
+        if (verbose())
+        { // Written at once, as other threads may be preparing files too.
+            std::stringstream sstream;
+            sstream << "Preprocessing file '" << path << std::endl;
+            std::cout << sstream.str();
+        }
+        auto ppedStr = m_runtime.parser_preprocessor().preprocess(m_runtime, contents, { path.string(), {} });
+        if (!ppedStr.has_value())
+        {
+            return file;
+        }
+        file.preprocessed = true;
+        if (key == "sqf" || key == "sqf2sqc")
         {
-            auto [path, contents] = generator();
-            if (key == "sqf")
+            if (m_parse_only)
             {
-                if (verbose()) { std::cout << "Preprocessing file '" << path << std::endl; }
-                auto ppedStr = m_runtime.parser_preprocessor().preprocess(m_runtime, contents, { path.string(), {} });
-                if (ppedStr.has_value())
-                {
-                    if (verbose()) { std::cout << "Parsing file '" << path << std::endl; }
-                    if (m_parse_only)
-                    {
-                        auto success = m_runtime.parser_sqf().check_syntax(m_runtime, *ppedStr, { path.string(), {} });
-                        m_good = m_good && !success;
-                    }
-                    else
-                    {
-                        auto set = m_runtime.parser_sqf().parse(m_runtime, *ppedStr, { path.string(), {} });
-                        if (set.has_value())
-                        {
-                            auto context = m_runtime.context_create().lock();
-                            sqf::runtime::frame f(m_runtime.default_value_scope(), *set);
-                            context->push_frame(f);
-                            context->name(path.string());
-                            if (verbose()) { std::cout << "Created Context '" << path << "'" << std::endl; }
-                        }
-                        else
-                        {
-                            m_good = false;
-                            std::cout << "Failed to parse file '" << path << "'" << std::endl;
-                        }
-                    }
-                }
-                else
-                {
-                    m_good = false;
-                    std::cout << "Failed to preprocess file '" << path << "'" << std::endl;
-                }
+                file.syntax = m_runtime.parser_sqf().check_syntax(m_runtime, *ppedStr, { path.string(), {} });
             }
-            else if (key == "config")
+            else
             {
-                if (verbose()) { std::cout << "Preprocessing file '" << path << std::endl; }
-                auto ppedStr = m_runtime.parser_preprocessor().preprocess(m_runtime, contents, { path.string(), {} });
-                if (ppedStr.has_value())
-                {
-                    if (verbose()) { std::cout << "Parsing file '" << path << std::endl; }
-                    if (m_parse_only)
-                    {
-                        auto success = !m_runtime.parser_config().check_syntax(*ppedStr, { path.string(), {} });
-                        m_good = m_good && !success;
-                    }
-                    else
-                    {
-                        auto success = m_runtime.parser_config().parse(m_runtime.confighost(), *ppedStr, { path.string(), {} });
-                        if (!success)
-                        {
-                            m_good = false;
-                            std::cout << "Failed to parse file '" << path << "'" << std::endl;
-                        }
-                    }
-                }
-                else
-                {
-                    m_good = false;
-                    std::cout << "Failed to preprocess file '" << path << "'" << std::endl;
-                }
+                file.set = m_runtime.parser_sqf().parse(m_runtime, *ppedStr, { path.string(), {} });
             }
-#if defined(SQF_SQC_SUPPORT)
-            else if (key == "sqc")
+        }
+        else if (key == "config")
+        {
+            auto config_parser = dynamic_cast<sqf::parser::config::parser*>(&m_runtime.parser_config());
+            if (m_parse_only)
             {
-                sqf::sqc::parser sqc_parser(m_logger);
-                if (verbose()) { std::cout << "Preprocessing file '" << path << std::endl; }
-                auto ppedStr = m_runtime.parser_preprocessor().preprocess(m_runtime, contents, { path.string(), {} });
-                if (ppedStr.has_value())
-                {
-                    if (verbose()) { std::cout << "Parsing file '" << path << std::endl; }
-                    if (m_parse_only)
-                    {
-                        auto success = sqc_parser.check_syntax(m_runtime, *ppedStr, { path.string(), {} });
-                        m_good = m_good && !success;
-                    }
-                    else
-                    {
-                        auto set = sqc_parser.parse(m_runtime, *ppedStr, { path.string(), {} });
-                        if (set.has_value())
-                        {
-                            auto context = m_runtime.context_create().lock();
-                            sqf::runtime::frame f(m_runtime.default_value_scope(), *set);
-                            context->push_frame(f);
-                            context->name(path.string());
-                            if (verbose()) { std::cout << "Created Context '" << path << "'" << std::endl; }
-                        }
-                        else
-                        {
-                            m_good = false;
-                            std::cout << "Failed to parse file '" << path << "'" << std::endl;
-                        }
-                    }
-                }
-                else
-                {
-                    m_good = false;
-                    std::cout << "Failed to preprocess file '" << path << "'" << std::endl;
-                }
+                file.syntax = m_runtime.parser_config().check_syntax(*ppedStr, { path.string(), {} });
             }
-            else if (key == "sqf2sqc")
+            else if (config_parser)
             {
-                if (verbose()) { std::cout << "Preprocessing file '" << path << std::endl; }
-                auto ppedStr = m_runtime.parser_preprocessor().preprocess(m_runtime, contents, { path.string(), {} });
-                if (ppedStr.has_value())
-                {
-                    if (verbose()) { std::cout << "Parsing file '" << path << std::endl; }
-                    if (m_parse_only)
-                    {
-                        auto success = m_runtime.parser_sqf().check_syntax(m_runtime, *ppedStr, { path.string(), {} });
-                        m_good = m_good && !success;
-                    }
-                    else
-                    {
-                        auto set = m_runtime.parser_sqf().parse(m_runtime, *ppedStr, { path.string(), {} });
-                        if (set.has_value())
-                        {
-                            auto path_sqc = path.replace_extension(".sqc");
-                            std::ofstream output_file(path_sqc, std::ios::out | std::ios::trunc);
-                            if (!output_file.is_open() || !output_file.good())
-                            {
-                                std::cout << "Failed to open output file '" << path_sqc << "'" << std::endl;
-                            }
-                            else
-                            {
-                                auto transpiled = ::sqf::sqc::parser::to_sqc(set.value());
-                                output_file << transpiled;
-
-                                if (verbose()) { std::cout << "Written out transpiled '" << path << "' to '" << path_sqc << "'." << std::endl; }
-                            }
-                        }
-                        else
-                        {
-                            m_good = false;
-                            std::cout << "Failed to parse file '" << path << "'" << std::endl;
-                        }
-                    }
-                }
-                else
-                {
-                    m_good = false;
-                    std::cout << "Failed to preprocess file '" << path << "'" << std::endl;
-                }
+                file.config = config_parser->parse_tree(std::move(*ppedStr), { path.string(), {} });
+            }
+            else
+            { // Unknown parser, has to parse and apply in one go.
+                file.contents = std::move(*ppedStr);
             }
-            else if (key == "sqc2sqf")
+        }
+#if defined(SQF_SQC_SUPPORT)
+        else if (key == "sqc" || key == "sqc2sqf")
+        {
+            sqf::sqc::parser sqc_parser(m_logger);
+            if (m_parse_only)
             {
-                sqf::sqc::parser sqc_parser(m_logger);
-                if (verbose()) { std::cout << "Preprocessing file '" << path << std::endl; }
-                auto ppedStr = m_runtime.parser_preprocessor().preprocess(m_runtime, contents, { path.string(), {} });
-                if (ppedStr.has_value())
-                {
-                    if (verbose()) { std::cout << "Parsing file '" << path << std::endl; }
-                    if (m_parse_only)
-                    {
-                        auto success = sqc_parser.check_syntax(m_runtime, *ppedStr, { path.string(), {} });
-                        m_good = m_good && !success;
-                    }
-                    else
-                    {
-                        auto set = sqc_parser.parse(m_runtime, *ppedStr, { path.string(), {} });
-                        if (set.has_value())
-                        {
-                            auto path_sqc = path.replace_extension(".sqf");
-                            std::ofstream output_file(path_sqc, std::ios::out | std::ios::trunc);
-                            if (!output_file.is_open() || !output_file.good())
-                            {
-                                std::cout << "Failed to open output file '" << path_sqc << "'" << std::endl;
-                            }
-                            else
-                            {
-                                auto transpiled = sqf::types::d_code(set.value()).to_string_sqf();
-                                if (transpiled.length() > 2)
-                                {
-                                    output_file << std::string_view(transpiled.data() + 1, transpiled.length() - 2);
-                                }
+                file.syntax = sqc_parser.check_syntax(m_runtime, *ppedStr, { path.string(), {} });
+            }
+            else
+            {
+                file.set = sqc_parser.parse(m_runtime, *ppedStr, { path.string(), {} });
+            }
+        }
+#endif
+    }
+    catch (...)
+    {
+        file.error = std::current_exception();
+    }
+    return file;
+}
 
-                                if (verbose()) { std::cout << "Written out transpiled '" << path << "' to '" << path_sqc << "'." << std::endl; }
-                            }
-                        }
-                        else
-                        {
-                            m_good = false;
-                            std::cout << "Failed to parse file '" << path << "'" << std::endl;
-                        }
-                    }
-                }
-                else
-                {
-                    m_good = false;
-                    std::cout << "Failed to preprocess file '" << path << "'" << std::endl;
-                }
+void cli::apply_file(prepared_file& file)
+{
+    if (file.error)
+    {
+        std::rethrow_exception(file.error);
+    }
+    auto& key = file.key;
+    auto& path = file.path;
+    if (!file.preprocessed)
+    {
+        m_good = false;
+        std::cout << "Failed to preprocess file '" << path << "'" << std::endl;
+        return;
+    }
+    if (verbose()) { std::cout << "Parsing file '" << path << std::endl; }
+    if (key == "config")
+    {
+        if (m_parse_only)
+        {
+            auto success = !file.syntax;
+            m_good = m_good && !success;
+            return;
+        }
+        bool success;
+        if (file.contents.has_value())
+        {
+            success = m_runtime.parser_config().parse(m_runtime.confighost(), std::move(*file.contents), { path.string(), {} });
+        }
+        else
+        {
+            success = file.config.has_value() && static_cast<sqf::parser::config::parser&>(m_runtime.parser_config()).apply(m_runtime.confighost(), *file.config);
+        }
+        if (!success)
+        {
+            m_good = false;
+            std::cout << "Failed to parse file '" << path << "'" << std::endl;
+        }
+        return;
+    }
+    if (m_parse_only)
+    {
+        m_good = m_good && !file.syntax;
+        return;
+    }
+    if (!file.set.has_value())
+    {
+        m_good = false;
+        std::cout << "Failed to parse file '" << path << "'" << std::endl;
+        return;
+    }
+    if (key == "sqf" || key == "sqc")
+    {
+        auto context = m_runtime.context_create().lock();
+        sqf::runtime::frame f(m_runtime.default_value_scope(), *file.set);
+        context->push_frame(std::move(f));
+        context->name(path.string());
+        if (verbose()) { std::cout << "Created Context '" << path << "'" << std::endl; }
+    }
+#if defined(SQF_SQC_SUPPORT)
+    else if (key == "sqf2sqc")
+    {
+        auto path_sqc = path.replace_extension(".sqc");
+        std::ofstream output_file(path_sqc, std::ios::out | std::ios::trunc);
+        if (!output_file.is_open() || !output_file.good())
+        {
+            std::cout << "Failed to open output file '" << path_sqc << "'" << std::endl;
+        }
+        else
+        {
+            auto transpiled = ::sqf::sqc::parser::to_sqc(file.set.value());
+            output_file << transpiled;
+
+            if (verbose()) { std::cout << "Written out transpiled '" << path << "' to '" << path_sqc << "'." << std::endl; }
+        }
+    }
+    else if (key == "sqc2sqf")
+    {
+        auto path_sqc = path.replace_extension(".sqf");
+        std::ofstream output_file(path_sqc, std::ios::out | std::ios::trunc);
+        if (!output_file.is_open() || !output_file.good())
+        {
+            std::cout << "Failed to open output file '" << path_sqc << "'" << std::endl;
+        }
+        else
+        {
+            auto transpiled = sqf::types::d_code(file.set.value()).to_string_sqf();
+            if (transpiled.length() > 2)
+            {
+                output_file << std::string_view(transpiled.data() + 1, transpiled.length() - 2);
             }
+
+            if (verbose()) { std::cout << "Written out transpiled '" << path << "' to '" << path_sqc << "'." << std::endl; }
+        }
+    }
 #endif
+}
+
+void cli::handle_files(size_t threads)
+{
+    std::vector<std::pair<const std::string*, const file_generator*>> queue;
+    for (auto& [key, generators] : m_files)
+    {
+        for (auto& generator : generators)
+        {
+            queue.emplace_back(&key, &generator);
+        }
+    }
+    if (threads <= 1 || queue.size() <= 1)
+    {
+        for (auto& [key, generator] : queue)
+        {
+            auto file = prepare_file(*key, *generator);
+            apply_file(file);
         }
+        return;
+    }
+
+    // Preprocessing and parsing only depend on the contents and the defines, hence can run concurrently.
+    // The results get loaded into the runtime afterwards, in the order the files were provided.
+    std::vector<prepared_file> prepared(queue.size());
+    std::atomic<size_t> next = 0;
+    auto worker = [&]() {
+        for (auto index = next++; index < queue.size(); index = next++)
+        {
+            prepared[index] = prepare_file(*queue[index].first, *queue[index].second);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < std::min(threads, queue.size()); i++)
+    {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& it : workers)
+    {
+        it.join();
+    }
+    for (auto& file : prepared)
+    {
+        apply_file(file);
     }
 }
 
@@ -345,6 +356,47 @@ cli::cli() : m_logger(), m_runtime(m_logger, {}), m_cli_file(false), m_parse_onl
 {
 }
 
+int cli::run_jobs(size_t argc, const char** argv, const std::vector<std::string>& sqf_files, size_t jobs)
+{
+    // Every job parses the same arguments again, but only loads its own SQF input file.
+    // Types got registered by this instance already, so the jobs only read the type registry.
+    std::atomic<size_t> next = 0;
+    std::atomic<int> exit_code = 0;
+    auto worker = [&]() {
+        for (auto index = next++; index < sqf_files.size(); index = next++)
+        {
+            auto job = std::make_unique<cli>();
+            job->m_job_input = sqf_files[index];
+            int res;
+            try
+            {
+                res = job->run(argc, argv);
+            }
+            catch (const std::exception& ex)
+            {
+                std::cerr << "Job for '" << sqf_files[index] << "' failed: " << ex.what() << std::endl;
+                res = -1;
+            }
+            if (res != 0)
+            {
+                int expected = 0;
+                exit_code.compare_exchange_strong(expected, res);
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < std::min(jobs, sqf_files.size()); i++)
+    {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& it : workers)
+    {
+        it.join();
+    }
+    return exit_code;
+}
+
 int cli::run(size_t argc, const char** argv)
 {
     std::string executable_path;
@@ -381,6 +433,8 @@ int cli::run(size_t argc, const char** argv)
     // CLI Configuration
     CMDADD(TCLAP::ValueArg<std::string>,    cliFileArg,                 "",     "cli-file",                 "Allows to provide a file from which to load arguments from. If passed, all other arguments will be ignored! Each argument needs to be separated by line-feed. " RELPATHHINT, false, "", "PATH");
     CMDADD(TCLAP::SwitchArg,                interactiveArg,             "",     "interactive",              "Starts into the interactive mode. Interactive mode will run the VM in a separate thread, allowing you to control the behavior via basic commands.", false);
+    CMDADD(TCLAP::ValueArg<long>,           jobsArg,                    "j",    "jobs",                     "Runs every SQF input file in its own, isolated runtime, using up to the provided amount of threads. Config files, PBOs and code provided via arguments get loaded into every runtime. Implies --automated.", false, 1, "COUNT");
+    CMDADD(TCLAP::ValueArg<long>,           loadThreadsArg,             "",     "load-threads",             "Preprocesses and parses the input files using up to the provided amount of threads. 0 uses one thread per core. Files still get executed and configs applied in the order provided, but only after all files got parsed. __COUNTER__ counts per file, hence the amount of threads does not affect it.", false, 1, "COUNT");
     CMDADD(TCLAP::SwitchArg,                automatedArg,               "a",    "automated",                "Disables CLI prompts.", false);
     CMDADD(TCLAP::SwitchArg,                suppressWelcomeArg,         "",     "suppress-welcome",         "Suppresses the welcome message during execution.", false);
     CMDADD(TCLAP::SwitchArg,                parseOnlyArg,               "",     "parse-only",               "Disables code execution and performs only parsing.", false);
@@ -390,9 +444,15 @@ int cli::run(size_t argc, const char** argv)
 
     // Runtime configuration
     CMDADD(TCLAP::ValueArg<long>,           maxRuntimeArg,              "m",    "max-runtime",              "Sets the maximum allowed runtime for the VM. 0 means no restriction in place.", false, 0, "MILLISECONDS");
+    CMDADD(TCLAP::ValueArg<long>,           maxContextInstructionsArg,  "",     "max-context-instructions", "Sets the maximum amount of instructions a single context (eg. a spawned script) may execute before it gets terminated. 0 means no restriction in place.", false, 0, "COUNT");
     CMDADD(TCLAP::SwitchArg,                enableClassnameCheckArg,    "c",    "check-classnames",         "Enables the config checking for eg. createVehicle.", false);
     CMDADD(TCLAP::SwitchArg,                noOperatorsArg,             "",     "no-operators",             "If provided, SQF-VM will not be loaded using the default set of operators it comes with (except for SQF-VM specific operators).", false);
     CMDADD(TCLAP::SwitchArg,                noWorkPrintArg,             "",     "no-work-print",            "Prevents the results printing of contexts that reached an empty state.", false);
+    CMDADD(TCLAP::SwitchArg,                optimizeArg,                "O",    "optimize",                 "Optimizes parsed SQF prior to execution by folding constant expressions and pre-building constant arrays. Reconstructed code (eg. str of CODE) will reflect the optimized form.", false);
+    CMDADD(TCLAP::ValueArg<long>,           compileCacheArg,            "",     "compile-cache",            "Sets the size of the cache holding the results of compile and execVM. 0 disables the cache.", false, 64, "MEGABYTES");
+    CMDADD(TCLAP::ValueArg<std::string>,    profileArg,                 "",     "profile",                  "Profiles the executed code. Writes folded stacks (eg. for flamegraph.pl), attributing the executed instructions to the frames they ran in, to the provided file and prints the hot lines after execution. " RELPATHHINT, false, "", "PATH");
+    CMDADD(TCLAP::ValueArg<long>,           profileTopArg,              "",     "profile-top",              "Sets the amount of hot lines printed when using --profile.", false, 20, "COUNT");
+    CMDADD(TCLAP::ValueArg<std::string>,    precompiledCacheArg,        "",     "precompiled-cache",        "Stores parsed SQF in the provided directory and reuses it on subsequent runs if the preprocessed contents, SQF-VM version and operators did not change. " RELPATHHINT, false, "", "PATH");
     CMDADD(TCLAP::MultiArg<std::string>,    virtualArg,                 "v",    "virtual",                  "Creates a mapping for a virtual and a physical path. Mapping is separated by a '|', with the left side being the physical, and the right argument the virtual path. " RELPATHHINT, false, "PATH|VIRTUAL");
 
     // Input - File
@@ -438,29 +498,39 @@ int cli::run(size_t argc, const char** argv)
         m_cli_file = true;
         return cli_from_file(argv[0], std::filesystem::path(cliFileArg.getValue()));
     }
-    m_automated = automatedArg.getValue();
+    m_automated = automatedArg.getValue() || m_job_input.has_value();
 
     /* Basic setup */ {
         m_runtime.parser_config(std::make_unique<sqf::parser::config::parser>(m_logger));
         m_runtime.parser_preprocessor(std::make_unique<sqf::parser::preprocessor::impl_default>(m_logger));
+        std::unique_ptr<sqf::runtime::parser::sqf> parser_sqf;
 #if defined(SQF_SQC_SUPPORT)
         if (parseSqcArg.getValue())
         {
-            m_runtime.parser_sqf(std::make_unique<sqf::sqc::parser>(m_logger));
+            parser_sqf = std::make_unique<sqf::sqc::parser>(m_logger);
         }
         else
         {
-            m_runtime.parser_sqf(std::make_unique<sqf::parser::sqf::parser>(m_logger));
+            parser_sqf = std::make_unique<sqf::parser::sqf::parser>(m_logger);
         }
 #else
-        m_runtime.parser_sqf(std::make_unique<sqf::parser::sqf::parser>(m_logger));
+        parser_sqf = std::make_unique<sqf::parser::sqf::parser>(m_logger);
 #endif
+        if (!precompiledCacheArg.getValue().empty())
+        {
+            parser_sqf = std::make_unique<sqf::parser::sqf::precompiled>(std::move(parser_sqf), std::filesystem::absolute(precompiledCacheArg.getValue()));
+        }
+        m_runtime.parser_sqf(std::move(parser_sqf));
         m_parse_only = parseOnlyArg.getValue();
     }
 
     /* Runtime configuration */ {
         m_runtime.configuration().max_runtime = std::chrono::milliseconds(maxRuntimeArg.getValue());
+        m_runtime.configuration().max_context_instructions = maxContextInstructionsArg.getValue() > 0 ? (size_t)maxContextInstructionsArg.getValue() : 0;
         m_runtime.configuration().enable_classname_check = enableClassnameCheckArg.getValue();
+        m_runtime.configuration().enable_optimizer = optimizeArg.getValue();
+        m_runtime.compile_cache().capacity(compileCacheArg.getValue() > 0 ? (size_t)compileCacheArg.getValue() * 1024 * 1024 : 0);
+        if (!profileArg.getValue().empty()) { m_runtime.profiler_enable(); }
         if (!noOperatorsArg.getValue()) { sqf::operators::ops(m_runtime); }
         m_runtime.configuration().print_context_work_to_log_on_exit = !noWorkPrintArg.getValue();
         mount_filesystem(virtualArg.getValue());
@@ -510,6 +580,14 @@ int cli::run(size_t argc, const char** argv)
             }
         }
 
+        if (m_job_input.has_value())
+        {
+            sqf_files = { *m_job_input };
+        }
+        else if (jobsArg.getValue() > 1 && sqf_files.size() > 1 && !interactiveArg.getValue())
+        {
+            return run_jobs(argc, argv, sqf_files, (size_t)jobsArg.getValue());
+        }
         for (auto rit = sqf_files.rbegin(); rit != sqf_files.rend(); ++rit)
         {
             std::filesystem::path path(*rit);
@@ -724,7 +802,7 @@ int cli::run(size_t argc, const char** argv)
         }
     }
 
-    handle_files();
+    handle_files(loadThreadsArg.getValue() > 0 ? (size_t)loadThreadsArg.getValue() : std::max<size_t>(1, std::thread::hardware_concurrency()));
 
     if (!m_good || m_parse_only)
     {
@@ -809,7 +887,7 @@ int cli::run(size_t argc, const char** argv)
                             else
                             {
                                 sqf::runtime::frame f(m_runtime.default_value_scope(), *set);
-                                m_runtime.context_active().push_frame(f);
+                                m_runtime.context_active().push_frame(std::move(f));
                             }
                         }
                         else
@@ -826,13 +904,13 @@ int cli::run(size_t argc, const char** argv)
 
 
             sqf::runtime::runtime::result result;
-            if (!noExecutePrintArg.getValue())
+            if (!noExecutePrintArg.getValue() && !m_job_input.has_value())
             {
                 std::cout << "Executing..." << std::endl;
                 std::cout << std::string(console_width(), '-') << std::endl;
             }
             result = m_runtime.execute(sqf::runtime::runtime::action::start);
-            if (!noExecutePrintArg.getValue())
+            if (!noExecutePrintArg.getValue() && !m_job_input.has_value())
             {
                 std::cout << std::string(console_width(), '-') << std::endl;
             }
@@ -870,6 +948,27 @@ int cli::run(size_t argc, const char** argv)
             }
         } while (!m_automated && !m_runtime.is_exit_requested());
     }
+    if (m_runtime.profiler())
+    {
+        std::filesystem::path path(profileArg.getValue());
+        if (m_job_input.has_value())
+        {
+            // Every job profiles its own runtime.
+            path += "." + std::filesystem::path(*m_job_input).filename().string();
+        }
+        std::ofstream output_file(path, std::ios::out | std::ios::trunc);
+        if (output_file.good())
+        {
+            m_runtime.profiler()->write_folded(output_file);
+        }
+        else
+        {
+            std::cout << "Failed to write profile to '" << path.string() << "'" << std::endl;
+        }
+        std::stringstream sstream;
+        m_runtime.profiler()->write_hot_lines(sstream, profileTopArg.getValue() > 0 ? (size_t)profileTopArg.getValue() : 0);
+        std::cout << sstream.str();
+    }
     auto exitcode = m_runtime.exit_code();
     if (exitcode.has_value())
     {
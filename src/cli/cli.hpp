@@ -1,6 +1,7 @@
 #pragma once
 #include "../runtime/logging.h"
 #include "../runtime/runtime.h"
+#include "../parser/config/config_parser.hpp"
 
 #include <filesystem>
 #include <vector>
@@ -8,6 +9,8 @@
 #include <unordered_map>
 #include <functional>
 #include <utility>
+#include <optional>
+#include <exception>
 
 namespace TCLAP
 {
@@ -22,9 +25,33 @@ class cli
     bool m_parse_only;
     bool m_good;
     bool m_automated;
-    std::unordered_map<std::string, std::vector<std::function<std::pair<std::filesystem::path, std::string>()>>> m_files;
+    using file_generator = std::function<std::pair<std::filesystem::path, std::string>()>;
+    std::unordered_map<std::string, std::vector<file_generator>> m_files;
+    // The only SQF input file to load if this instance got created by run_jobs.
+    std::optional<std::string> m_job_input;
 
-    void handle_files();
+    // An input file that got preprocessed and parsed, but is not yet loaded into the runtime.
+    struct prepared_file
+    {
+        std::string key;
+        std::filesystem::path path;
+        // Set if loading the file threw, rethrown when the file gets applied.
+        std::exception_ptr error;
+        bool preprocessed = false;
+        // Result of the syntax check if running with --parse-only.
+        bool syntax = false;
+        std::optional<sqf::runtime::instruction_set> set;
+        std::optional<sqf::parser::config::parser::tree> config;
+        // Preprocessed config contents, if the config parser cannot parse them separately.
+        std::optional<std::string> contents;
+    };
+
+    // Preprocesses and parses the file. Does not touch the runtime state, hence may run concurrently.
+    prepared_file prepare_file(const std::string& key, const file_generator& generator);
+    // Loads the prepared file into the runtime.
+    void apply_file(prepared_file& file);
+    void handle_files(size_t threads);
+    int run_jobs(size_t argc, const char** argv, const std::vector<std::string>& sqf_files, size_t jobs);
     void mount_filesystem(const std::vector<std::string>& mappings);
     int cli_from_file(const char* arg0, std::filesystem::path path);
 public:
@@ -22,7 +22,7 @@ void interactive_helper::virtualmachine_thread()
             std::this_thread::sleep_for(std::chrono::milliseconds(10));
             break;
         default:
-            m_runtime.execute(m_runtime_apply_action);
+            m_runtime.execute(tmp);
             break;
         }
 
@@ -131,9 +131,36 @@ void interactive_helper::init()
             }
 
             line = std::stol(arg.data());
-            file = arg.substr(split);
+            file = arg.substr(split + 1);
             interactive.runtime().push_back({ line, file });
         });
+    register_command(std::array{ "cbp"s, "set-conditional-breakpoint"s },
+        "Sets a breakpoint at the provided line & file, that only halts if the provided SQF condition evaluates to true.\n"
+        "Example: `cbp 20 C:\\file\\path\\dot.sqf|_i > 5`\n"
+        "with the number marking the line, the string in quotes being the file path and the expression after the pipe being the condition.",
+        [](interactive_helper& interactive, std::string_view arg) -> void {
+            size_t line;
+            std::string file;
+            std::string condition;
+
+            auto split = arg.find(' ');
+            if (split == std::string::npos)
+            {
+                std::cerr << "set-conditional-breakpoint is unable to find file." << std::endl;
+                return;
+            }
+            auto condition_split = arg.find('|', split);
+            if (condition_split == std::string::npos)
+            {
+                std::cerr << "set-conditional-breakpoint is unable to find condition." << std::endl;
+                return;
+            }
+
+            line = std::stol(arg.data());
+            file = arg.substr(split + 1, condition_split - split - 1);
+            condition = arg.substr(condition_split + 1);
+            interactive.runtime().push_back({ line, file, condition });
+        });
     register_command(std::array{ "rbp"s, "remove-breapoint"s },
         "Removes a breakpoint from the provided line & file.\n"
         "Example: `rbp 20 C:\\file\\path\\dot.sqf`\n"
@@ -150,7 +177,7 @@ void interactive_helper::init()
             }
 
             line = std::stol(arg.data());
-            file = arg.substr(split);
+            file = arg.substr(split + 1);
             auto res = std::find_if(interactive.runtime().breakpoints_begin(), interactive.runtime().breakpoints_end(),
                 [line, file](const sqf::runtime::diagnostics::breakpoint& bp)
                 { return bp.line() == line && bp.file() == file; });
@@ -267,7 +294,7 @@ void interactive_helper::init()
                 {
                     std::cout << i++ << ":\tnamespace: " << it->globals_value_scope()->scope_name()
                         << "\tscopename: " << it->scope_name()
-                        << std::endl << (*it->current())->diag_info().code_segment << std::endl;
+                        << std::endl << (*it->current())->diag_info().code_segment() << std::endl;
                 }
             } break;
             }
@@ -286,7 +313,8 @@ void interactive_helper::init()
                 auto selected_context = interactive.context_selected();
                 if (!selected_context)
                 {
-                    interactive.context_selected(interactive.runtime().context_active_as_shared());
+                    selected_context = interactive.runtime().context_active_as_shared();
+                    interactive.context_selected(selected_context);
                     std::cout << "Selected context no longer available. Changing to Currently Active." << std::endl;
                 }
 
@@ -294,9 +322,9 @@ void interactive_helper::init()
                 size_t space_index = 0;
                 for (auto it_frame = selected_context->frames_rbegin(); it_frame != selected_context->frames_rend(); ++it_frame)
                 {
-                    for (auto it_var = it_frame->begin(); it_var != it_frame->end(); ++it_var)
+                    for (auto& it_var : it_frame->variables())
                     {
-                        std::cout << "[" << std::setw(3) << space_index << "] '" << it_var->first << "' := " << it_var->second.to_string_sqf() << std::endl;
+                        std::cout << "[" << std::setw(3) << space_index << "] '" << it_var.first.name() << "' := " << it_var.second.to_string_sqf() << std::endl;
                     }
                 }
             } break;
@@ -309,6 +337,7 @@ void interactive_helper::init()
             auto value = interactive.runtime().evaluate_expression(std::string(arg), success);
             if (success)
             {
+                auto format_scope = interactive.runtime().scalar_format_scope();
                 std::cout << value.to_string_sqf() << std::endl;
             }
             else
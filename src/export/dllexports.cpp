@@ -13,6 +13,9 @@
 #include <functional>
 #include <optional>
 #include <memory>
+#include <sstream>
+#include <cstring>
+#include <algorithm>
 
 using namespace std::string_view_literals;
 
@@ -348,4 +351,77 @@ extern "C" {
             return -1;
         }
     }
+    DLLEXPORT_PREFIX int32_t sqfvm_set_optimizer(void* instance, int32_t enabled)
+    {
+        auto result = dllexports::with_instance_do(instance, [&](dllexports::instance& ref) -> int32_t {
+            ref.runtime->configuration().enable_optimizer = enabled != 0;
+            return 0;
+        });
+        if (result.has_value())
+        {
+            return result.value();
+        }
+        else
+        {
+            return -1;
+        }
+    }
+    DLLEXPORT_PREFIX int32_t sqfvm_set_profiler(void* instance, int32_t enabled)
+    {
+        auto result = dllexports::with_instance_do(instance, [&](dllexports::instance& ref) -> int32_t {
+            if (enabled != 0)
+            {
+                ref.runtime->profiler_enable();
+            }
+            else
+            {
+                ref.runtime->profiler_disable();
+            }
+            return 0;
+        });
+        if (result.has_value())
+        {
+            return result.value();
+        }
+        else
+        {
+            return -1;
+        }
+    }
+    DLLEXPORT_PREFIX int32_t sqfvm_get_profile(void* instance, char type, char* buffer, uint32_t length)
+    {
+        const int32_t instance_invalid = -1;
+        const int32_t profiler_disabled = -2;
+        const int32_t invalid_type = -5;
+        auto result = dllexports::with_instance_do(instance, [&](dllexports::instance& ref) -> int32_t {
+            auto profiler = ref.runtime->profiler();
+            if (!profiler)
+            {
+                return profiler_disabled;
+            }
+            std::stringstream sstream;
+            switch (type)
+            {
+                case 'f': profiler->write_folded(sstream); break;
+                case 'h': profiler->write_hot_lines(sstream, 20); break;
+                default: return invalid_type;
+            }
+            auto str = sstream.str();
+            if (length > 0)
+            {
+                auto copied = std::min<size_t>(str.length(), length - 1);
+                std::memcpy(buffer, str.data(), copied);
+                buffer[copied] = '\0';
+            }
+            return static_cast<int32_t>(str.length());
+        });
+        if (result.has_value())
+        {
+            return result.value();
+        }
+        else
+        {
+            return instance_invalid;
+        }
+    }
 }
\ No newline at end of file
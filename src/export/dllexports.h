@@ -67,6 +67,39 @@ extern "C" {
     //         
     DLLEXPORT_PREFIX int32_t sqfvm_status(void* instance);
 
+    // Enables or disables the optimizer for SQF parsed by the instance.
+    // The optimizer is disabled by default.
+    // @param instance A valid instance as returned from sqfvm_create_instance
+    // @param enabled 0 to disable, any other value to enable the optimizer
+    // @return -1 if the instance was null
+    //          0 on success
+    DLLEXPORT_PREFIX int32_t sqfvm_set_optimizer(void* instance, int32_t enabled);
+
+    // Enables or disables the profiler of the instance.
+    // While enabled, every executed instruction gets attributed to its source line and the frames it ran in.
+    // Disabling the profiler discards everything recorded.
+    // The profiler is disabled by default.
+    // @param instance A valid instance as returned from sqfvm_create_instance
+    // @param enabled 0 to disable, any other value to enable the profiler
+    // @return -1 if the instance was null
+    //          0 on success
+    DLLEXPORT_PREFIX int32_t sqfvm_set_profiler(void* instance, int32_t enabled);
+
+    // Writes what the profiler of the instance recorded so far into the provided buffer.
+    // The output is always null terminated and gets truncated if the buffer is too small.
+    // @param instance A valid instance as returned from sqfvm_create_instance
+    // @param type The report to write.
+    //             Can be one of the following values:
+    //             - 'f' denotes folded stacks, compatible with flamegraph.pl
+    //             - 'h' denotes a table of the 20 hottest source lines
+    // @param buffer The buffer to write the report to. May be NULL if length is 0.
+    // @param length The length of buffer.
+    // @return The length of the full report, excluding the null terminator, on success
+    //         -1 if the instance was null
+    //         -2 if the profiler is disabled
+    //         -5 if the provided type was invalid
+    DLLEXPORT_PREFIX int32_t sqfvm_get_profile(void* instance, char type, char* buffer, uint32_t length);
+
     // Calls the provided code, using the SQF-VM instance.
     // @param instance A valid instance as returned from sqfvm_create_instance
     // @param call_data data that will be passed into the callback for logs of the given instance
@@ -3,6 +3,7 @@
 #include "../runtime/value.h"
 #include "../runtime/data.h"
 #include "../runtime/runtime.h"
+#include "../runtime/symbol.h"
 
 #include <string>
 #include <string_view>
@@ -16,10 +17,13 @@ namespace sqf::opcodes
         std::string ___TYPE = "assign_to";
 #endif
         std::string m_variable_name;
+        sqf::runtime::symbol m_variable;
+        std::shared_ptr<const sqf::runtime::local_layout> m_layout;
+        size_t m_slot;
 
     public:
-        assign_to(std::string value) : m_variable_name(value) {}
-        assign_to(std::string_view value) : m_variable_name(value.begin(), value.end()) {}
+        assign_to(std::string value) : m_variable_name(value), m_variable(value), m_slot(0) {}
+        assign_to(std::string_view value) : m_variable_name(value.begin(), value.end()), m_variable(value), m_slot(0) {}
         virtual void execute(sqf::runtime::runtime& vm) const override
         {
             auto& context = vm.context_active();
@@ -44,24 +48,40 @@ namespace sqf::opcodes
             if (m_variable_name.empty()) { return; }
             if (m_variable_name[0] == '_')
             {
+                auto& frame = context.current_frame();
+                if (m_layout && frame.layout() == m_layout.get())
+                {
+                    if (auto res = frame.slot(m_slot))
+                    {
+                        *res = *value;
+                        return;
+                    }
+                }
                 for (auto it = context.frames_rbegin(); it != context.frames_rend(); ++it)
                 {
-                    if (it->contains(m_variable_name))
+                    if (auto res = it->find(m_variable))
                     {
-                        (*it)[m_variable_name] = *value;
+                        *res = *value;
                         return;
                     }
                 }
-                context.current_frame()[m_variable_name] = *value;
+                context.current_frame()[m_variable] = *value;
             }
             else
             {
-                context.current_frame().globals_value_scope()->at(m_variable_name) = *value;
+                context.current_frame().globals_value_scope()->at(m_variable) = *value;
             }
         }
         virtual std::string to_string() const override { return std::string("ASSIGNTO ") + m_variable_name; }
         std::string_view variable_name() const { return m_variable_name; }
 
+        virtual const sqf::runtime::symbol* local_variable() const override { return !m_variable_name.empty() && m_variable_name[0] == '_' ? &m_variable : nullptr; }
+        virtual void local_slot(std::shared_ptr<const sqf::runtime::local_layout> layout, size_t slot) override
+        {
+            m_layout = layout;
+            m_slot = slot;
+        }
+
         virtual std::optional<std::string> reconstruct(
             std::vector<sqf::runtime::instruction::sptr>::const_reverse_iterator& current,
             std::vector<sqf::runtime::instruction::sptr>::const_reverse_iterator end,
@@ -84,5 +104,6 @@ namespace sqf::opcodes
             auto casted = dynamic_cast<const assign_to*>(p_other);
             return casted != nullptr && casted->m_variable_name == m_variable_name;
         }
+        virtual std::size_t hash() const override { return hash_combine(typeid(*this).hash_code(), std::hash<std::string>()(m_variable_name)); }
     };
 }
\ No newline at end of file
@@ -17,9 +17,12 @@ namespace sqf::opcodes
     private:
         std::string m_operator_name;
         short m_precedence;
+        // Overload set resolved on first execution, valid as long as the runtime reports the same sqfop_revision.
+        mutable std::shared_ptr<const sqf::runtime::sqfop_binary_table> m_table;
+        mutable size_t m_table_revision;
 
     public:
-        call_binary(std::string key, short precedence) : m_operator_name(key), m_precedence(precedence) {}
+        call_binary(std::string key, short precedence) : m_operator_name(key), m_precedence(precedence), m_table_revision(0) {}
         virtual void execute(sqf::runtime::runtime& vm) const override
         {
             auto& context = vm.context_active();
@@ -66,27 +69,18 @@ namespace sqf::opcodes
 
             auto tleft = left_value->type();
             auto tright = right_value->type();
-            sqf::runtime::sqfop_binary::key key = { m_operator_name, tleft, tright };
-
-            if (!vm.sqfop_exists(key))
+            if (m_table_revision != vm.sqfop_revision())
             {
-                key = { m_operator_name, sqf::types::t_any(), tright };
-                if (!vm.sqfop_exists(key))
-                {
-                    key = { m_operator_name, tleft, sqf::types::t_any() };
-                    if (!vm.sqfop_exists(key))
-                    {
-                        key = { m_operator_name, sqf::types::t_any(), sqf::types::t_any() };
-                        if (!vm.sqfop_exists(key))
-                        {
-                            vm.__logmsg(logmessage::runtime::UnknownInputTypeCombinationBinary(diag_info(), tleft, key.name, tright));
-                            return;
-                        }
-                    }
-                }
+                m_table = vm.sqfop_resolve_binary(m_operator_name);
+                m_table_revision = vm.sqfop_revision();
+            }
+            auto op = m_table->at(tleft, tright);
+            if (!op)
+            {
+                vm.__logmsg(logmessage::runtime::UnknownInputTypeCombinationBinary(diag_info(), tleft, m_operator_name, tright));
+                return;
             }
-            auto op = vm.sqfop_at(key);
-            auto return_value = op.execute(vm, *left_value, *right_value);
+            auto return_value = op->execute(vm, *left_value, *right_value);
 
             context.push_value(return_value);
         }
@@ -132,5 +126,6 @@ namespace sqf::opcodes
             auto casted = dynamic_cast<const call_binary*>(p_other);
             return casted != nullptr && casted->m_operator_name == m_operator_name;
         }
+        virtual std::size_t hash() const override { return hash_combine(typeid(*this).hash_code(), std::hash<std::string>()(m_operator_name)); }
     };
 }
\ No newline at end of file
@@ -20,20 +20,26 @@ namespace sqf::opcodes
 #endif
     private:
         std::string m_operator_name;
+        // Operator resolved on first execution, valid as long as the runtime reports the same sqfop_revision.
+        mutable const sqf::runtime::sqfop_nular* m_operator;
+        mutable size_t m_operator_revision;
 
     public:
-        call_nular(std::string key) : m_operator_name(key) {}
+        call_nular(std::string key) : m_operator_name(key), m_operator(nullptr), m_operator_revision(0) {}
         virtual void execute(sqf::runtime::runtime& vm) const override
         {
             auto& context = vm.context_active();
-            sqf::runtime::sqfop_nular::key key = { m_operator_name };
-            if (!vm.sqfop_exists(key))
+            if (m_operator_revision != vm.sqfop_revision())
             {
-                vm.__logmsg(logmessage::runtime::UnknownInputTypeCombinationNular(diag_info(), key.name));
+                m_operator = vm.sqfop_resolve_nular(m_operator_name);
+                m_operator_revision = vm.sqfop_revision();
+            }
+            if (!m_operator)
+            {
+                vm.__logmsg(logmessage::runtime::UnknownInputTypeCombinationNular(diag_info(), m_operator_name));
                 return;
             }
-            auto op = vm.sqfop_at(key);
-            auto return_value = op.execute(vm);
+            auto return_value = m_operator->execute(vm);
 
             context.push_value(return_value);
         }
@@ -52,5 +58,6 @@ namespace sqf::opcodes
             auto casted = dynamic_cast<const call_nular*>(p_other);
             return casted != nullptr && casted->m_operator_name == m_operator_name;
         }
+        virtual std::size_t hash() const override { return hash_combine(typeid(*this).hash_code(), std::hash<std::string>()(m_operator_name)); }
     };
 }
\ No newline at end of file
@@ -15,9 +15,12 @@ namespace sqf::opcodes
 #endif
     private:
         std::string m_operator_name;
+        // Overload set resolved on first execution, valid as long as the runtime reports the same sqfop_revision.
+        mutable std::shared_ptr<const sqf::runtime::sqfop_unary_table> m_table;
+        mutable size_t m_table_revision;
 
     public:
-        call_unary(std::string key) : m_operator_name(key) {}
+        call_unary(std::string key) : m_operator_name(key), m_table_revision(0) {}
         virtual void execute(sqf::runtime::runtime& vm) const override
         {
             auto& context = vm.context_active();
@@ -42,18 +45,18 @@ namespace sqf::opcodes
             }
             
             auto tright = right_value->operator sqf::runtime::type();
-            sqf::runtime::sqfop_unary::key key = { m_operator_name, tright };
-            if (!vm.sqfop_exists(key))
+            if (m_table_revision != vm.sqfop_revision())
             {
-                key = { m_operator_name, sqf::types::t_any() };
-                if (!vm.sqfop_exists(key))
-                {
-                    vm.__logmsg(logmessage::runtime::UnknownInputTypeCombinationUnary(diag_info(), key.name, tright));
-                    return;
-                }
+                m_table = vm.sqfop_resolve_unary(m_operator_name);
+                m_table_revision = vm.sqfop_revision();
+            }
+            auto op = m_table->at(tright);
+            if (!op)
+            {
+                vm.__logmsg(logmessage::runtime::UnknownInputTypeCombinationUnary(diag_info(), m_operator_name, tright));
+                return;
             }
-            auto op = vm.sqfop_at(key);
-            auto return_value = op.execute(vm, *right_value);
+            auto return_value = op->execute(vm, *right_value);
 
             context.push_value(return_value);
         }
@@ -81,5 +84,6 @@ namespace sqf::opcodes
             auto casted = dynamic_cast<const call_unary*>(p_other);
             return casted != nullptr && casted->m_operator_name == m_operator_name;
         }
+        virtual std::size_t hash() const override { return hash_combine(typeid(*this).hash_code(), std::hash<std::string>()(m_operator_name)); }
     };
 }
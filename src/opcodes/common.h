@@ -6,4 +6,5 @@
 #include "../opcodes/end_statement.h"
 #include "../opcodes/get_variable.h"
 #include "../opcodes/make_array.h"
-#include "../opcodes/push.h"
\ No newline at end of file
+#include "../opcodes/push.h"
+#include "../opcodes/push_array.h"
\ No newline at end of file
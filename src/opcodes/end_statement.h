@@ -12,6 +12,7 @@ namespace sqf::opcodes
     public:
         virtual void execute(sqf::runtime::runtime& vm) const override { vm.context_active().clear_values(); }
         virtual std::string to_string() const override { return "ENDSTATEMENT"; }
+        virtual void lower(sqf::runtime::bytecode& code) const override { code.emit_end_statement(); }
         virtual std::optional<std::string> reconstruct(
             std::vector<sqf::runtime::instruction::sptr>::const_reverse_iterator& current,
             std::vector<sqf::runtime::instruction::sptr>::const_reverse_iterator end,
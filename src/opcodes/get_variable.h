@@ -3,6 +3,7 @@
 #include "../runtime/runtime.h"
 #include "../runtime/value.h"
 #include "../runtime/value_scope.h"
+#include "../runtime/symbol.h"
 
 #include <string>
 
@@ -19,14 +20,26 @@ namespace sqf::opcodes
         std::string ___TYPE = "get_variable";
 #endif
         std::string m_variable_name;
+        sqf::runtime::symbol m_variable;
+        std::shared_ptr<const sqf::runtime::local_layout> m_layout;
+        size_t m_slot;
     public:
-        get_variable(std::string variable_name) : m_variable_name(variable_name) {}
-        get_variable(std::string_view value) : m_variable_name(value.begin(), value.end()) {}
+        get_variable(std::string variable_name) : m_variable_name(variable_name), m_variable(variable_name), m_slot(0) {}
+        get_variable(std::string_view value) : m_variable_name(value.begin(), value.end()), m_variable(value), m_slot(0) {}
         virtual void execute(sqf::runtime::runtime& vm) const override
         {
             if (m_variable_name[0] == '_')
             { // local variable
-                auto opt = vm.context_active().get_variable(m_variable_name);
+                auto& frame = vm.context_active().current_frame();
+                if (m_layout && frame.layout() == m_layout.get())
+                {
+                    if (auto res = frame.slot(m_slot))
+                    {
+                        vm.context_active().push_value(*res);
+                        return;
+                    }
+                }
+                auto opt = vm.context_active().get_variable(m_variable);
                 if (opt.has_value())
                 {
                     vm.context_active().push_value(*opt);
@@ -40,9 +53,9 @@ namespace sqf::opcodes
             else
             { // global variable
                 auto global_scope = vm.context_active().current_frame().globals_value_scope();
-                if (global_scope->contains(m_variable_name))
+                if (auto res = global_scope->find(m_variable))
                 {
-                    vm.context_active().push_value(global_scope->at(m_variable_name));
+                    vm.context_active().push_value(*res);
                 }
                 else
                 {
@@ -54,6 +67,13 @@ namespace sqf::opcodes
         std::string to_string() const override { return "GETVARIABLE " + m_variable_name; }
         std::string variable_name() const { return m_variable_name; }
 
+        virtual const sqf::runtime::symbol* local_variable() const override { return !m_variable_name.empty() && m_variable_name[0] == '_' ? &m_variable : nullptr; }
+        virtual void local_slot(std::shared_ptr<const sqf::runtime::local_layout> layout, size_t slot) override
+        {
+            m_layout = layout;
+            m_slot = slot;
+        }
+
         virtual std::optional<std::string> reconstruct(
             std::vector<sqf::runtime::instruction::sptr>::const_reverse_iterator& current,
             std::vector<sqf::runtime::instruction::sptr>::const_reverse_iterator end,
@@ -67,5 +87,6 @@ namespace sqf::opcodes
             auto casted = dynamic_cast<const get_variable*>(p_other);
             return casted != nullptr && casted->m_variable_name == m_variable_name;
         }
+        virtual std::size_t hash() const override { return hash_combine(typeid(*this).hash_code(), std::hash<std::string>()(m_variable_name)); }
     };
 }
@@ -19,6 +19,7 @@ namespace sqf::opcodes
         virtual void execute(sqf::runtime::runtime& vm) const override { vm.context_active().push_value(m_value); }
         virtual std::string to_string() const override { return std::string("PUSH ") + m_value.to_string_sqf(); }
         sqf::runtime::value::cref value() const { return m_value; }
+        virtual void lower(sqf::runtime::bytecode& code) const override { code.emit_push(m_value); }
         virtual std::optional<std::string> reconstruct(
             std::vector<sqf::runtime::instruction::sptr>::const_reverse_iterator& current,
             std::vector<sqf::runtime::instruction::sptr>::const_reverse_iterator end,
@@ -26,7 +27,7 @@ namespace sqf::opcodes
         {
             if (!m_value.empty())
             {
-                return m_value.data<::sqf::runtime::data>()->to_string_sqf();
+                return m_value.to_string_sqf();
             }
             else
             {
@@ -39,5 +40,6 @@ namespace sqf::opcodes
             auto casted = dynamic_cast<const push*>(p_other);
             return casted != nullptr && casted->m_value == m_value;
         }
+        virtual std::size_t hash() const override { return m_value.hash(); }
     };
 }
@@ -0,0 +1,30 @@
+#pragma once
+#include "push.h"
+#include "../runtime/d_array.h"
+
+namespace sqf::opcodes
+{
+    /// <summary>
+    /// Pushes a copy of a constant array.
+    /// Created by the optimizer in place of a make_array with only constant elements.
+    /// As arrays are mutable, every execution pushes a fresh deep copy.
+    /// </summary>
+    class push_array : public push
+    {
+    private:
+#if _DEBUG
+        std::string ___TYPE = "push_array";
+#endif
+    public:
+        push_array(std::shared_ptr<sqf::types::d_array> arr) : push(sqf::runtime::value(arr)) {}
+        virtual void execute(sqf::runtime::runtime& vm) const override { vm.context_active().push_value(value().data<sqf::types::d_array>()->copy_deep()); }
+        virtual std::string to_string() const override { return std::string("PUSHARRAY ") + value().to_string_sqf(); }
+        virtual void lower(sqf::runtime::bytecode& code) const override { code.emit_instruction(); }
+
+        virtual bool equals(const instruction* p_other) const override
+        {
+            auto casted = dynamic_cast<const push_array*>(p_other);
+            return casted != nullptr && casted->value() == value();
+        }
+    };
+}
@@ -2,6 +2,7 @@
 #include "../runtime/data.h"
 #include "../runtime/type.h"
 #include "../runtime/value.h"
+#include "../runtime/runtime.h"
 
 #include <string>
 #include <memory>
@@ -84,10 +85,10 @@ namespace sqf
                 return m_value;
             }
 
-        private:
-            static bool& friendly_map(side is, side with)
+            class side_storage : public sqf::runtime::runtime::datastorage
             {
-                static bool arr[__MAX_SIDE][__MAX_SIDE] = {
+            public:
+                bool friendly[__MAX_SIDE][__MAX_SIDE] = {
                    { false, false, false, false, false, false, false, false, true , true  }, // empty
                    { false, false, false, false, false, false, false, false, true , true  }, // unknown
                    { true , false, true , true , false, true , false, false, true , true  }, // civ
@@ -98,13 +99,12 @@ namespace sqf
                    { false, false, false, false, false, false, false, false, true , true  }, // friendly
                    { true , true , true , true , true , true , true , true , true , true  }, // ambient
                 };
-                return arr[is][with];
-            }
-        public:
-            bool is_friendly_to(side other) const { return is_friendly_to(m_value, other); }
-            void set_friendly_to(side other, bool flag) const { set_friendly_to(m_value, other, flag); }
-            static bool is_friendly_to(side self, side other) { return friendly_map(self, other); }
-            static void set_friendly_to(side self, side other, bool flag) { friendly_map(self, other) = flag; }
+                virtual ~side_storage() override {}
+            };
+            bool is_friendly_to(sqf::runtime::runtime& runtime, side other) const { return is_friendly_to(runtime, m_value, other); }
+            void set_friendly_to(sqf::runtime::runtime& runtime, side other, bool flag) const { set_friendly_to(runtime, m_value, other, flag); }
+            static bool is_friendly_to(sqf::runtime::runtime& runtime, side self, side other) { return runtime.storage<side_storage>().friendly[self][other]; }
+            static void set_friendly_to(sqf::runtime::runtime& runtime, side self, side other, bool flag) { runtime.storage<side_storage>().friendly[self][other] = flag; }
         };
         template<>
         inline std::shared_ptr<sqf::runtime::data> to_data<d_side::side>(d_side::side side)
@@ -170,28 +170,28 @@ bool sqf::types::object::update_values_from_confighost(sqf::runtime::confighost
 
     m_configuration.has_commander = extract<d_boolean, bool>(nav / "hasCommander", false);
 
-    m_configuration.transport_soldier = (size_t)extract<d_scalar, float>(nav / "transportSoldier", false);
+    m_configuration.transport_soldier = (size_t)extract<d_scalar, sqf::runtime::scalar_t>(nav / "transportSoldier", false);
     m_soldiers.m_inner.resize(m_configuration.transport_soldier);
 
     return true;
 }
 
 
-float sqf::types::object::distance3dsqr(std::array<float, 3> otherpos) const
+sqf::runtime::scalar_t sqf::types::object::distance3dsqr(std::array<sqf::runtime::scalar_t, 3> otherpos) const
 {
-    return sqf::types::distance3dsqr(std::array<float, 3> { m_position.x, m_position.y, m_position.z  }, otherpos);
+    return sqf::types::distance3dsqr(std::array<sqf::runtime::scalar_t, 3> { m_position.x, m_position.y, m_position.z  }, otherpos);
 }
-float sqf::types::object::distance3d(std::array<float, 3> otherpos) const
+sqf::runtime::scalar_t sqf::types::object::distance3d(std::array<sqf::runtime::scalar_t, 3> otherpos) const
 {
-    return sqf::types::distance3d(std::array<float, 3> { m_position.x, m_position.y, m_position.z  }, otherpos);
+    return sqf::types::distance3d(std::array<sqf::runtime::scalar_t, 3> { m_position.x, m_position.y, m_position.z  }, otherpos);
 }
-float sqf::types::object::distance2dsqr(std::array<float, 2> otherpos) const
+sqf::runtime::scalar_t sqf::types::object::distance2dsqr(std::array<sqf::runtime::scalar_t, 2> otherpos) const
 {
-    return sqf::types::distance2dsqr(std::array<float, 2> { m_position.x, m_position.y  }, otherpos);
+    return sqf::types::distance2dsqr(std::array<sqf::runtime::scalar_t, 2> { m_position.x, m_position.y  }, otherpos);
 }
-float sqf::types::object::distance2d(std::array<float, 2> otherpos) const
+sqf::runtime::scalar_t sqf::types::object::distance2d(std::array<sqf::runtime::scalar_t, 2> otherpos) const
 {
-    return sqf::types::distance2d(std::array<float, 2> { m_position.x, m_position.y }, otherpos);
+    return sqf::types::distance2d(std::array<sqf::runtime::scalar_t, 2> { m_position.x, m_position.y }, otherpos);
 }
 
 #pragma endregion
@@ -93,7 +93,7 @@ namespace sqf
             bool m_is_vehicle;
 
             std::string m_varname;
-            float m_damage;
+            sqf::runtime::scalar_t m_damage;
             std::shared_ptr<d_group> m_group;
 
             ::sqf::runtime::vec3 m_position;
@@ -126,9 +126,9 @@ namespace sqf
             std::shared_ptr<d_group> group() const { return m_group; }
             void group(std::shared_ptr<d_group> g) { m_group = g; }
 
-            float damage() const { return m_damage; }
-            void damage(float val) { m_damage = val < 0 ? 0 : val > 1 ? 1 : val; }
-            void damage_by(float val) { auto newdmg = m_damage += val; damage(newdmg); }
+            sqf::runtime::scalar_t damage() const { return m_damage; }
+            void damage(sqf::runtime::scalar_t val) { m_damage = val < 0 ? 0 : val > 1 ? 1 : val; }
+            void damage_by(sqf::runtime::scalar_t val) { auto newdmg = m_damage += val; damage(newdmg); }
 
             /// <summary>
             /// d_object this object is part of (eg. Unit X sits in Vehicle Y, Y will be parent of X)
@@ -176,23 +176,23 @@ namespace sqf
 
 
 
-            float distance3dsqr(std::shared_ptr<object> obj) const { return distance3dsqr(obj->position()); }
-            float distance3dsqr(const object* obj) const { return distance3dsqr(obj->position()); }
-            float distance3dsqr(::sqf::runtime::vec3 obj) const { return distance3dsqr(std::array<float, 3>{ obj.x, obj.y, obj.z }); }
-            float distance3dsqr(std::array<float, 3> obj) const;
-            float distance3d(std::shared_ptr<object> obj) const { return distance3d(obj->position()); }
-            float distance3d(const object* obj) const { return distance3d(obj->position()); }
-            float distance3d(::sqf::runtime::vec3 obj) const { return distance3d(std::array<float, 3>{ obj.x, obj.y, obj.z }); }
-            float distance3d(std::array<float, 3> obj) const;
-
-            float distance2dsqr(std::shared_ptr<object> obj) const { return distance2dsqr(obj->position()); }
-            float distance2dsqr(const object* obj) const { return distance2dsqr(obj->position()); }
-            float distance2dsqr(::sqf::runtime::vec3 obj) const { return distance2dsqr(std::array<float, 2>{ obj.x, obj.y }); }
-            float distance2dsqr(std::array<float, 2> obj) const;
-            float distance2d(std::shared_ptr<object> obj) const { return distance2d(obj->position()); }
-            float distance2d(const object* obj) const { return distance2d(obj->position()); }
-            float distance2d(::sqf::runtime::vec3 obj) const { return distance2d(std::array<float, 2>{ obj.x, obj.y }); }
-            float distance2d(std::array<float, 2> obj) const;
+            sqf::runtime::scalar_t distance3dsqr(std::shared_ptr<object> obj) const { return distance3dsqr(obj->position()); }
+            sqf::runtime::scalar_t distance3dsqr(const object* obj) const { return distance3dsqr(obj->position()); }
+            sqf::runtime::scalar_t distance3dsqr(::sqf::runtime::vec3 obj) const { return distance3dsqr(std::array<sqf::runtime::scalar_t, 3>{ obj.x, obj.y, obj.z }); }
+            sqf::runtime::scalar_t distance3dsqr(std::array<sqf::runtime::scalar_t, 3> obj) const;
+            sqf::runtime::scalar_t distance3d(std::shared_ptr<object> obj) const { return distance3d(obj->position()); }
+            sqf::runtime::scalar_t distance3d(const object* obj) const { return distance3d(obj->position()); }
+            sqf::runtime::scalar_t distance3d(::sqf::runtime::vec3 obj) const { return distance3d(std::array<sqf::runtime::scalar_t, 3>{ obj.x, obj.y, obj.z }); }
+            sqf::runtime::scalar_t distance3d(std::array<sqf::runtime::scalar_t, 3> obj) const;
+
+            sqf::runtime::scalar_t distance2dsqr(std::shared_ptr<object> obj) const { return distance2dsqr(obj->position()); }
+            sqf::runtime::scalar_t distance2dsqr(const object* obj) const { return distance2dsqr(obj->position()); }
+            sqf::runtime::scalar_t distance2dsqr(::sqf::runtime::vec3 obj) const { return distance2dsqr(std::array<sqf::runtime::scalar_t, 2>{ obj.x, obj.y }); }
+            sqf::runtime::scalar_t distance2dsqr(std::array<sqf::runtime::scalar_t, 2> obj) const;
+            sqf::runtime::scalar_t distance2d(std::shared_ptr<object> obj) const { return distance2d(obj->position()); }
+            sqf::runtime::scalar_t distance2d(const object* obj) const { return distance2d(obj->position()); }
+            sqf::runtime::scalar_t distance2d(::sqf::runtime::vec3 obj) const { return distance2d(std::array<sqf::runtime::scalar_t, 2>{ obj.x, obj.y }); }
+            sqf::runtime::scalar_t distance2d(std::array<sqf::runtime::scalar_t, 2> obj) const;
         };
     }
 }
@@ -0,0 +1,41 @@
+#include "ops.h"
+#include "../runtime/runtime.h"
+#include "../runtime/logging.h"
+
+namespace
+{
+    std::shared_ptr<const sqf::runtime::sqfop_set> create_operators()
+    {
+        // Registration happens on a scratch runtime, so no state besides the operators
+        // leaks into the shared set. Nothing gets logged while registering operators.
+        StdOutLogger logger;
+        sqf::runtime::runtime runtime(logger, {});
+        sqf::operators::ops_config(runtime);
+        sqf::operators::ops_diag(runtime);
+        sqf::operators::ops_generic(runtime);
+        sqf::operators::ops_group(runtime);
+        sqf::operators::ops_logic(runtime);
+        sqf::operators::ops_markers(runtime);
+        sqf::operators::ops_math(runtime);
+        sqf::operators::ops_namespace(runtime);
+        sqf::operators::ops_object(runtime);
+        sqf::operators::ops_sqfvm(runtime);
+        sqf::operators::ops_string(runtime);
+        sqf::operators::ops_text(runtime);
+        sqf::operators::ops_dummy_nular(runtime);
+        sqf::operators::ops_dummy_unary(runtime);
+        sqf::operators::ops_dummy_binary(runtime);
+        sqf::operators::ops_osspecific(runtime);
+        sqf::operators::ops_hashmap(runtime);
+        return runtime.sqfop_freeze();
+    }
+}
+
+void sqf::operators::ops(::sqf::runtime::runtime& runtime)
+{
+    static const std::shared_ptr<const sqf::runtime::sqfop_set> operators = create_operators();
+    runtime.sqfop_share(operators);
+
+    // Done by ops_namespace too, but not part of the shared operators.
+    runtime.default_value_scope(sqf::runtime::missionNamespace);
+}
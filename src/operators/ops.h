@@ -26,25 +26,11 @@ namespace sqf
 
     namespace operators
     {
-        inline void ops(::sqf::runtime::runtime& runtime)
-        {
-            sqf::operators::ops_config(runtime);
-            sqf::operators::ops_diag(runtime);
-            sqf::operators::ops_generic(runtime);
-            sqf::operators::ops_group(runtime);
-            sqf::operators::ops_logic(runtime);
-            sqf::operators::ops_markers(runtime);
-            sqf::operators::ops_math(runtime);
-            sqf::operators::ops_namespace(runtime);
-            sqf::operators::ops_object(runtime);
-            sqf::operators::ops_sqfvm(runtime);
-            sqf::operators::ops_string(runtime);
-            sqf::operators::ops_text(runtime);
-            sqf::operators::ops_dummy_nular(runtime);
-            sqf::operators::ops_dummy_unary(runtime);
-            sqf::operators::ops_dummy_binary(runtime);
-            sqf::operators::ops_osspecific(runtime);
-            sqf::operators::ops_hashmap(runtime);
-        }
+        /// <summary>
+        /// Makes all operators available to the provided runtime.
+        /// The operators get registered only once per process, into an immutable set
+        /// that is shared by every runtime passed in here.
+        /// </summary>
+        void ops(::sqf::runtime::runtime& runtime);
     }
 }
\ No newline at end of file
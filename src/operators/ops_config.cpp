@@ -112,7 +112,7 @@ namespace
         {
             runtime.__logmsg(err::ExpectedNonNullValue(runtime.context_active().current_frame().diag_info_from_position()));
             runtime.__logmsg(err::ReturningEmptyArray(runtime.context_active().current_frame().diag_info_from_position()));
-            return std::make_shared<d_array>();
+            return sqf::runtime::make_pooled<d_array>();
         }
         // Get navigation path
         std::vector<value> path;
@@ -196,7 +196,7 @@ namespace
             runtime.__logmsg(err::ReturningScalarZero(runtime.context_active().current_frame().diag_info_from_position()));
             return 0;
         }
-        return nav->value.data_try<d_scalar, float>(0.0F);
+        return nav->value.data_try<d_scalar, sqf::runtime::scalar_t>(0.0F);
     }
     value gettext_config(runtime& runtime, value::cref right)
     {
@@ -218,7 +218,7 @@ namespace
         {
             runtime.__logmsg(err::ExpectedNonNullValue(runtime.context_active().current_frame().diag_info_from_position()));
             runtime.__logmsg(err::ReturningEmptyArray(runtime.context_active().current_frame().diag_info_from_position()));
-            return std::make_shared<d_array>();
+            return sqf::runtime::make_pooled<d_array>();
         }
         auto data = nav->value.data_try<d_array>();
         if (data)
@@ -227,7 +227,7 @@ namespace
         }
         else
         {
-            return std::make_shared<d_array>();
+            return sqf::runtime::make_pooled<d_array>();
         }
     }
     value isnull_config(runtime& runtime, value::cref right)
@@ -244,7 +244,7 @@ namespace
             confignav m_confignav;
             confignav::iterator m_iterator_current;
         public:
-            behavior_configclasses_exit(confignav confignav) : m_out_arr(std::make_shared<d_array>()), m_confignav(confignav), m_iterator_current(confignav.begin()) {}
+            behavior_configclasses_exit(confignav confignav) : m_out_arr(sqf::runtime::make_pooled<d_array>()), m_confignav(confignav), m_iterator_current(confignav.begin()) {}
             virtual result enact(sqf::runtime::runtime& runtime, sqf::runtime::frame& frame) override
             {
                 auto res = runtime.context_active().pop_value();
@@ -287,22 +287,21 @@ namespace
         {
             runtime.__logmsg(err::ExpectedNonNullValue(runtime.context_active().current_frame().diag_info_from_position()));
             runtime.__logmsg(err::ReturningEmptyArray(runtime.context_active().current_frame().diag_info_from_position()));
-            return std::make_shared<d_array>();
+            return sqf::runtime::make_pooled<d_array>();
         }
         if (nav->size() == 0)
         {
-            return std::make_shared<d_array>();
+            return sqf::runtime::make_pooled<d_array>();
         }
         else
         {
-            auto& parser = runtime.parser_sqf();
-            auto res = parser.parse(runtime, code, runtime.context_active().current_frame().diag_info_from_position().path);
+            auto res = runtime.parse_sqf_cached(code, runtime.context_active().current_frame().diag_info_from_position().path());
 
             if (res.has_value())
             {
                 frame f(runtime.default_value_scope(), res.value(), std::make_shared<behavior_configclasses_exit>(nav));
                 f["_x"] = nav->operator[](0);
-                runtime.context_active().push_frame(f);
+                runtime.context_active().push_frame(std::move(f));
             }
         }
         return {};
@@ -316,7 +315,7 @@ namespace
             confignav m_confignav;
             confignav::iterator m_iterator_current;
         public:
-            behavior_configproperties_exit(confignav confignav) : m_out_arr(std::make_shared<d_array>()), m_confignav(confignav), m_iterator_current(confignav.begin()) {}
+            behavior_configproperties_exit(confignav confignav) : m_out_arr(sqf::runtime::make_pooled<d_array>()), m_confignav(confignav), m_iterator_current(confignav.begin()) {}
             virtual result enact(sqf::runtime::runtime& runtime, sqf::runtime::frame& frame) override
             {
                 auto res = runtime.context_active().pop_value();
@@ -366,22 +365,21 @@ namespace
             {
                 runtime.__logmsg(err::ExpectedNonNullValue(runtime.context_active().current_frame().diag_info_from_position()));
                 runtime.__logmsg(err::ReturningEmptyArray(runtime.context_active().current_frame().diag_info_from_position()));
-                return std::make_shared<d_array>();
+                return sqf::runtime::make_pooled<d_array>();
             }
             if (nav->size() == 0)
             {
-                return std::make_shared<d_array>();
+                return sqf::runtime::make_pooled<d_array>();
             }
             else
             {
-                auto& parser = runtime.parser_sqf();
-                auto res = parser.parse(runtime, code, runtime.context_active().current_frame().diag_info_from_position().path);
+                auto res = runtime.parse_sqf_cached(code, runtime.context_active().current_frame().diag_info_from_position().path());
 
                 if (res.has_value())
                 {
                     frame f(runtime.default_value_scope(), res.value(), std::make_shared<behavior_configproperties_exit>(nav));
                     f["_x"] = nav->operator[](0);
-                    runtime.context_active().push_frame(f);
+                    runtime.context_active().push_frame(std::move(f));
                 }
             }
             return {};
@@ -27,12 +27,11 @@ namespace
         // Time is since beginning of game so long is fine.
         long long r = static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(curtime - starttime).count());
         double d = r * 0.001;
-        float f = (float)d;
-        return { f };
+        return { d };
     }
     value assert_bool(runtime& runtime, value::cref right)
     {
-        auto r = right.data<d_boolean>()->value();
+        auto r = right.data<d_boolean, bool>();
         if (!r)
         {
             runtime.__logmsg(err::AssertFailed(runtime.context_active().current_frame().diag_info_from_position()));
@@ -73,17 +73,15 @@ namespace
     }
     value call_code(runtime& runtime, value::cref right)
     {
-        frame f = { runtime.default_value_scope(), right.data<d_code, instruction_set>() };
         auto _this = runtime.context_active().get_variable("_this");
-        f["_this"] = _this.has_value() ? *_this : value{};
-        runtime.context_active().push_frame(f);
+        auto& f = runtime.context_active().emplace_frame(runtime.default_value_scope(), right.data<d_code, instruction_set>());
+        f["_this"] = _this.has_value() ? std::move(*_this) : value{};
         return {};
     }
     value call_any_code(runtime& runtime, value::cref left, value::cref right)
     {
-        frame f = { runtime.default_value_scope(), right.data<d_code, instruction_set>() };
+        auto& f = runtime.context_active().emplace_frame(runtime.default_value_scope(), right.data<d_code, instruction_set>());
         f["_this"] = left;
-        runtime.context_active().push_frame(f);
         return {};
     }
     value count_array(runtime& runtime, value::cref right)
@@ -153,15 +151,14 @@ namespace
         {
             frame f(runtime.default_value_scope(), left.data<d_code, instruction_set>(), std::make_shared<behavior_count_exit>(r));
             f["_x"] = r->at(0);
-            runtime.context_active().push_frame(f);
+            runtime.context_active().push_frame(std::move(f));
         }
         return {};
     }
     value compile_string(runtime& runtime, value::cref right)
     {
         auto r = right.data<d_string, std::string>();
-        auto& parser = runtime.parser_sqf();
-        auto res = parser.parse(runtime, r, runtime.context_active().current_frame().diag_info_from_position().path);
+        auto res = runtime.parse_sqf_cached(r, runtime.context_active().current_frame().diag_info_from_position().path());
         if (!res.has_value())
         {
             runtime.__runtime_error() = true;
@@ -211,7 +208,7 @@ namespace
             }
             if (el0.is<t_code>())
             {
-                runtime.context_active().push_frame({ runtime.default_value_scope(), el0.data<d_code, instruction_set>() });
+                runtime.context_active().emplace_frame(runtime.default_value_scope(), el0.data<d_code, instruction_set>());
                 return {};
             }
             else
@@ -228,7 +225,7 @@ namespace
             }
             if (el1.is<t_code>())
             {
-                runtime.context_active().push_frame({ runtime.default_value_scope(), el1.data<d_code, instruction_set>() });
+                runtime.context_active().emplace_frame(runtime.default_value_scope(), el1.data<d_code, instruction_set>());
                 return {};
             }
             else
@@ -243,7 +240,7 @@ namespace
         auto ifcond = left.data<d_boolean, bool>();
         if (ifcond)
         {
-            runtime.context_active().push_frame({ runtime.default_value_scope(), right.data<d_code, instruction_set>() });
+            runtime.context_active().emplace_frame(runtime.default_value_scope(), right.data<d_code, instruction_set>());
             return {};
         }
         else
@@ -256,7 +253,7 @@ namespace
         if (left.data<d_boolean, bool>())
         {
             runtime.context_active().current_frame().die();
-            runtime.context_active().push_frame({ runtime.default_value_scope(), right.data<d_code, instruction_set>() });
+            runtime.context_active().emplace_frame(runtime.default_value_scope(), right.data<d_code, instruction_set>());
             return {};
         }
         else
@@ -313,7 +310,7 @@ namespace
         };
 
         frame f(runtime.default_value_scope(), right.data<d_code, instruction_set>(), std::make_shared<behavior_waituntil_exit>());
-        runtime.context_active().push_frame(f);
+        runtime.context_active().push_frame(std::move(f));
         return {};
     }
     value while_code(runtime& runtime, value::cref right)
@@ -398,7 +395,7 @@ namespace
         }
 
         frame f(runtime.default_value_scope(), condition, std::make_shared<behavior_while_exit>(condition, code));
-        runtime.context_active().push_frame(f);
+        runtime.context_active().push_frame(std::move(f));
         return {};
     }
     value for_string(runtime& runtime, value::cref right)
@@ -411,21 +408,21 @@ namespace
     value from_for_scalar(runtime& runtime, value::cref left, value::cref right)
     {
         auto fordata = left.data<d_for>();
-        auto index = right.data<d_scalar, float>();
+        auto index = right.data<d_scalar, sqf::runtime::scalar_t>();
         fordata->from(index);
         return left;
     }
     value to_for_scalar(runtime& runtime, value::cref left, value::cref right)
     {
         auto fordata = left.data<d_for>();
-        auto index = right.data<d_scalar, float>();
+        auto index = right.data<d_scalar, sqf::runtime::scalar_t>();
         fordata->to(index);
         return left;
     }
     value step_for_scalar(runtime& runtime, value::cref left, value::cref right)
     {
         auto fordata = left.data<d_for>();
-        auto index = right.data<d_scalar, float>();
+        auto index = right.data<d_scalar, sqf::runtime::scalar_t>();
         fordata->step(index);
         return left;
     }
@@ -435,13 +432,13 @@ namespace
         {
         private:
             d_for m_for;
-            float m_value;
+            sqf::runtime::scalar_t m_value;
         public:
             behavior_for_exit(std::shared_ptr<d_for> fordata) : m_for(*fordata), m_value(m_for.from()) {}
             virtual result enact(sqf::runtime::runtime& runtime, sqf::runtime::frame& frame) override
             {
                 auto res = frame[m_for.variable()];
-                auto value = res.data_try<d_scalar, float>();
+                auto value = res.data_try<d_scalar, sqf::runtime::scalar_t>();
                 if (value.has_value())
                 {
                     // Check if exit condition is met
@@ -478,7 +475,7 @@ namespace
             auto step = fordata->step();
 
 
-            auto step_is_rero = std::abs(step) <= std::numeric_limits<float>::epsilon(); 
+            auto step_is_rero = std::abs(step) <= std::numeric_limits<sqf::runtime::scalar_t>::epsilon(); 
             if (!step_is_rero && (step > 0 ? from > to : to > from))
             {
                 return {};
@@ -486,7 +483,7 @@ namespace
         }
         frame f(runtime.default_value_scope(), right.data<d_code, instruction_set>(), std::make_shared<behavior_for_exit>(fordata));
         f[fordata->variable()] = fordata->from();
-        runtime.context_active().push_frame(f);
+        runtime.context_active().push_frame(std::move(f));
         return {};
     }
     value foreach_code_array(runtime& runtime, value::cref left, value::cref right)
@@ -526,14 +523,14 @@ namespace
             frame f(runtime.default_value_scope(), left.data<d_code, instruction_set>(), std::make_shared<behavior_foreach_exit>(arr));
             f["_forEachIndex"] = 0;
             f["_x"] = arr->at(0);
-            runtime.context_active().push_frame(f);
+            runtime.context_active().push_frame(std::move(f));
         }
         return {};
     }
     value select_array_scalar(runtime& runtime, value::cref left, value::cref right)
     {
         auto arr = left.data<d_array>()->value();
-        auto index = static_cast<int>(std::round(right.data<d_scalar, float>()));
+        auto index = static_cast<int>(std::round(right.data<d_scalar, sqf::runtime::scalar_t>()));
 
         if (static_cast<int>(arr.size()) < index || index < 0)
         {
@@ -586,18 +583,18 @@ namespace
             runtime.__logmsg(err::ExpectedArrayTypeMissmatch(runtime.context_active().current_frame().diag_info_from_position(), 1, t_scalar(), arr[0].type()));
             return {};
         }
-        int start = static_cast<int>(std::round(arr[0].data<d_scalar, float>()));
+        int start = static_cast<int>(std::round(arr[0].data<d_scalar, sqf::runtime::scalar_t>()));
         if (start < 0)
         {
             runtime.__logmsg(err::NegativeIndexWeak(runtime.context_active().current_frame().diag_info_from_position()));
             runtime.__logmsg(err::ReturningEmptyArray(runtime.context_active().current_frame().diag_info_from_position()));
-            return value(std::make_shared<d_array>());
+            return value(sqf::runtime::make_pooled<d_array>());
         }
         if (start > static_cast<int>(vec.size()))
         {
             runtime.__logmsg(err::IndexOutOfRangeWeak(runtime.context_active().current_frame().diag_info_from_position(), vec.size(), start));
             runtime.__logmsg(err::ReturningEmptyArray(runtime.context_active().current_frame().diag_info_from_position()));
-            return value(std::make_shared<d_array>());
+            return value(sqf::runtime::make_pooled<d_array>());
         }
         if (arr.size() >= 2)
         {
@@ -606,19 +603,19 @@ namespace
                 runtime.__logmsg(err::ExpectedArrayTypeMissmatch(runtime.context_active().current_frame().diag_info_from_position(), 1, t_scalar(), arr[1].type()));
                 return {};
             }
-            int length = static_cast<int>(std::round(arr[1].data<d_scalar, float>()));
+            int length = static_cast<int>(std::round(arr[1].data<d_scalar, sqf::runtime::scalar_t>()));
             if (length < 0)
             {
                 runtime.__logmsg(err::NegativeIndexWeak(runtime.context_active().current_frame().diag_info_from_position()));
                 runtime.__logmsg(err::ReturningEmptyArray(runtime.context_active().current_frame().diag_info_from_position()));
-                return value(std::make_shared<d_array>());
+                return value(sqf::runtime::make_pooled<d_array>());
             }
 
             return value(std::vector<value>(vec.begin() + start, start + length > static_cast<int>(vec.size()) ? vec.end() : vec.begin() + start + length));
         }
         else
         {
-            return value(std::make_shared<d_array>());
+            return value(sqf::runtime::make_pooled<d_array>());
         }
 
     }
@@ -683,7 +680,7 @@ namespace
         {
             frame f(runtime.default_value_scope(), right.data<d_code, instruction_set>(), std::make_shared<behavior_select_exit>(arr));
             f["_x"] = arr->at(0);
-            runtime.context_active().push_frame(f);
+            runtime.context_active().push_frame(std::move(f));
             return {};
         }
         return std::vector<value>();
@@ -740,8 +737,8 @@ namespace
                     }
                     else if (a.is<t_scalar>())
                     {
-                        if (a_elem.data<d_scalar, float>() < b_elem.data<d_scalar, float>()) return sort_flag;
-                        if (a_elem.data<d_scalar, float>() > b_elem.data<d_scalar, float>()) return !sort_flag;
+                        if (a_elem.data<d_scalar, sqf::runtime::scalar_t>() < b_elem.data<d_scalar, sqf::runtime::scalar_t>()) return sort_flag;
+                        if (a_elem.data<d_scalar, sqf::runtime::scalar_t>() > b_elem.data<d_scalar, sqf::runtime::scalar_t>()) return !sort_flag;
                     }
                 }
                 return !sort_flag;
@@ -754,8 +751,8 @@ namespace
             }
             else if (a.is<t_scalar>())
             {
-                if (a.data<d_scalar, float>() < b.data<d_scalar, float>()) return sort_flag;
-                if (a.data<d_scalar, float>() > b.data<d_scalar, float>()) return !sort_flag;
+                if (a.data<d_scalar, sqf::runtime::scalar_t>() < b.data<d_scalar, sqf::runtime::scalar_t>()) return sort_flag;
+                if (a.data<d_scalar, sqf::runtime::scalar_t>() > b.data<d_scalar, sqf::runtime::scalar_t>()) return !sort_flag;
                 return false;
             }
             return !sort_flag;
@@ -780,8 +777,8 @@ namespace
         {
             return {};
         }
-        auto from = (int)std::roundf((*right.data<d_array>())[0].data<d_scalar, float>());
-        auto to = (int)std::roundf((*right.data<d_array>())[1].data<d_scalar, float>());
+        auto from = (int)std::roundf((*right.data<d_array>())[0].data<d_scalar, sqf::runtime::scalar_t>());
+        auto to = (int)std::roundf((*right.data<d_array>())[1].data<d_scalar, sqf::runtime::scalar_t>());
 
         auto arr = left.data<d_array>();
         if (from > to)
@@ -891,7 +888,7 @@ namespace
         {
             frame f(runtime.default_value_scope(), right.data<d_code, instruction_set>(), std::make_shared<behavior_findif_exit>(r));
             f["_x"] = r->at(0);
-            runtime.context_active().push_frame(f);
+            runtime.context_active().push_frame(std::move(f));
             return {};
         }
         else
@@ -956,8 +953,7 @@ namespace
                 auto res = runtime.context_active().pop_value();
                 if (res.has_value())
                 {
-                    auto value = res->data();
-                    runtime.context_active().push_value(value.get() ? false : true);
+                    runtime.context_active().push_value(res->empty());
                 }
                 else
                 {
@@ -968,7 +964,7 @@ namespace
         };
 
         frame f(runtime.default_value_scope(), right.data<d_code, instruction_set>(), std::make_shared<behavior_isnil_exit>());
-        runtime.context_active().push_frame(f);
+        runtime.context_active().push_frame(std::move(f));
         return {};
     }
     value hint_string(runtime& runtime, value::cref right)
@@ -1023,7 +1019,7 @@ namespace
 
         frame f(runtime.default_value_scope(), right.data<d_code, instruction_set>(), std::make_shared<behavior_switch_exit>());
         f[d_switch::magic] = left;
-        runtime.context_active().push_frame(f);
+        runtime.context_active().push_frame(std::move(f));
         return {};
     }
     value case_any(runtime& runtime, value::cref right)
@@ -1123,7 +1119,7 @@ namespace
         {
             frame f(runtime.default_value_scope(), right.data<d_code, instruction_set>(), std::make_shared<behavior_apply_exit>(arr));
             f["_x"] = arr->at(0);
-            runtime.context_active().push_frame(f);
+            runtime.context_active().push_frame(std::move(f));
             return {};
         }
         return std::vector<value>();
@@ -1138,7 +1134,7 @@ namespace
         frame f(runtime.default_value_scope(), right.data<d_code, instruction_set>());
         f["_thisScript"] = scriptdata;
         f["_this"] = left;
-        lock->push_frame(f);
+        lock->push_frame(std::move(f));
         return scriptdata;
     }
     value scriptnull_(runtime& runtime)
@@ -1200,18 +1196,16 @@ namespace
             return {};
         }
         auto val = params[1];
+        if (arr->would_recurse(val))
+        {
+            runtime.__logmsg(err::ArrayRecursion(runtime.context_active().current_frame().diag_info_from_position()));
+            return {};
+        }
         if (static_cast<int>(arr->size()) <= index)
         {
             arr->resize(index + 1);
         }
-        auto oldval = (*arr)[index];
         (*arr)[index] = val;
-        if (!arr->recursion_test())
-        {
-            (*arr)[index] = oldval;
-            runtime.__logmsg(err::ArrayRecursion(runtime.context_active().current_frame().diag_info_from_position()));
-            return {};
-        }
         return {};
     }
     value plus_array(runtime& runtime, value::cref right)
@@ -1249,7 +1243,20 @@ namespace
     {
         auto arr = left.data<d_array>();
         auto r = right.data<d_array>();
-        arr->insert(arr->end(), r->begin(), r->end());
+        if (std::any_of(r->begin(), r->end(), [&arr](value::cref it) { return arr->would_recurse(it); }))
+        {
+            runtime.__logmsg(err::ArrayRecursion(runtime.context_active().current_frame().diag_info_from_position()));
+            return {};
+        }
+        if (arr == r)
+        {
+            auto copy = r->value();
+            arr->insert(arr->end(), copy.begin(), copy.end());
+        }
+        else
+        {
+            arr->insert(arr->end(), r->begin(), r->end());
+        }
         return {};
     }
     value arrayintersect_array_array(runtime& runtime, value::cref left, value::cref right)
@@ -1305,15 +1312,15 @@ namespace
     value selectmax_array(runtime& runtime, value::cref right)
     {
         auto r = right.data<d_array>();
-        double max = std::numeric_limits<float>::lowest();
+        double max = std::numeric_limits<sqf::runtime::scalar_t>::lowest();
         for (size_t i = r->size() - 1; i != ~(size_t)0; i--)
         {
             auto tmp = r->at(i);
             if (tmp.is<t_scalar>())
             {
-                if (tmp.data<d_scalar, float>() > max)
+                if (tmp.data<d_scalar, sqf::runtime::scalar_t>() > max)
                 {
-                    max = tmp.data<d_scalar, float>();
+                    max = tmp.data<d_scalar, sqf::runtime::scalar_t>();
                 }
             }
             else if (tmp.is<t_boolean>())
@@ -1337,15 +1344,15 @@ namespace
     value selectmin_array(runtime& runtime, value::cref right)
     {
         auto r = right.data<d_array>();
-        double min = std::numeric_limits<float>::max();
+        double min = std::numeric_limits<sqf::runtime::scalar_t>::max();
         for (size_t i = r->size() - 1; i != ~(size_t)0; i--)
         {
             auto tmp = r->at(i);
             if (tmp.is<t_scalar>())
             {
-                if (tmp.data<d_scalar, float>() < min)
+                if (tmp.data<d_scalar, sqf::runtime::scalar_t>() < min)
                 {
-                    min = tmp.data<d_scalar, float>();
+                    min = tmp.data<d_scalar, sqf::runtime::scalar_t>();
                 }
             }
             else if (tmp.is<t_boolean>())
@@ -1387,7 +1394,7 @@ namespace
             dlname += ".so";
         #endif
 
-        static char buffer[CALLEXTVERSIONBUFFSIZE + 1] = { 0 };
+        char buffer[CALLEXTVERSIONBUFFSIZE + 1] = { 0 };
         for (auto it : runtime.storage<dlops, sqf::operators::dlops_storage>())
         {
             if (it->path() == dlname)
@@ -1498,7 +1505,7 @@ namespace
         }
         else
         {
-            arr = std::make_shared<d_array>();
+            arr = sqf::runtime::make_pooled<d_array>();
             arr->push_back(rvec->at(1));
         }
         std::vector<std::string> argstringvec;
@@ -1563,7 +1570,7 @@ namespace
         }
         else
         {
-            input_values = std::make_shared<d_array>();
+            input_values = sqf::runtime::make_pooled<d_array>();
             input_values->push_back(src);
         }
 
@@ -1683,7 +1690,7 @@ namespace
         }
         if (!_this->is<t_array>())
         {
-            auto arr = std::make_shared<d_array>();
+            auto arr = sqf::runtime::make_pooled<d_array>();
             arr->push_back(*_this);
             return param_any_array(runtime, arr, right);
         }
@@ -1818,7 +1825,7 @@ namespace
         }
         if (!_this->is<t_array>())
         {
-            auto arr = std::make_shared<d_array>();
+            auto arr = sqf::runtime::make_pooled<d_array>();
             arr->push_back(*_this);
             return params_array_array(runtime, arr, right);
         }
@@ -1840,8 +1847,8 @@ namespace
             return {};
         }
 
-        float f = right.data<d_scalar, float>();
-        auto duration = std::chrono::duration<float>(f);
+        auto f = right.data<d_scalar, sqf::runtime::scalar_t>();
+        auto duration = std::chrono::duration<sqf::runtime::scalar_t>(f);
         auto durationCasted = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
 
         runtime.context_active().suspend(durationCasted);
@@ -1927,7 +1934,7 @@ namespace
         auto starttime = runtime.runtime_timestamp();
         // Time is since beginning of game so long is fine.
         long r = static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(curtime - starttime).count());
-        return (float)r * 0.001;
+        return r * 0.001;
     }
     value throw_any(runtime& runtime, value::cref right)
     {
@@ -2012,7 +2019,7 @@ namespace
             left.data<d_code, sqf::runtime::instruction_set>(),
             {},
             std::make_shared<behavior_catch_exit>(right.data<d_code, sqf::runtime::instruction_set>()));
-        runtime.context_active().push_frame(f);
+        runtime.context_active().push_frame(std::move(f));
         return {};
     }
     value execvm_any_string(runtime& runtime, value::cref left, value::cref right)
@@ -2025,9 +2032,7 @@ namespace
             auto str = preproc.preprocess(runtime, *pathinfo);
             if (str.has_value())
             {
-                auto r = right.data<d_string, std::string>();
-                auto& parser = runtime.parser_sqf();
-                auto res = parser.parse(runtime, r, runtime.context_active().current_frame().diag_info_from_position().path);
+                auto res = runtime.parse_sqf_cached(*str, *pathinfo);
                 if (res.has_value())
                 {
                     auto context_weak = runtime.context_create();
@@ -2036,7 +2041,7 @@ namespace
                     frame f(runtime.default_value_scope(), res.value());
                     f["_thisScript"] = scriptdata;
                     f["_this"] = left;
-                    lock->push_frame(f);
+                    lock->push_frame(std::move(f));
                     return scriptdata;
                 }
                 else
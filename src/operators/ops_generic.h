@@ -144,9 +144,9 @@ namespace sqf
             using data_type = sqf::runtime::t_for;
         private:
             std::string m_variable;
-            float m_from;
-            float m_to;
-            float m_step;
+            sqf::runtime::scalar_t m_from;
+            sqf::runtime::scalar_t m_to;
+            sqf::runtime::scalar_t m_step;
         protected:
             bool do_equals(std::shared_ptr<sqf::runtime::data> other, bool invariant) const override
             {
@@ -170,20 +170,20 @@ namespace sqf
             {
                 size_t hash = 0x9e3779b9;
                 hash ^= std::hash<std::string>()(m_variable) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-                hash ^= std::hash<float>()(m_from) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-                hash ^= std::hash<float>()(m_to) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-                hash ^= std::hash<float>()(m_step) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+                hash ^= std::hash<sqf::runtime::scalar_t>()(m_from) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+                hash ^= std::hash<sqf::runtime::scalar_t>()(m_to) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+                hash ^= std::hash<sqf::runtime::scalar_t>()(m_step) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
                 return hash;
             }
 
             std::string variable() const { return m_variable; }
             void variable(std::string value) { m_variable = value; }
-            float from() const { return m_from; }
-            void from(float value) { m_from = value; }
-            float to() const { return m_to; }
-            void to(float value) { m_to = value; }
-            float step() const { return m_step; }
-            void step(float value) { m_step = value; }
+            sqf::runtime::scalar_t from() const { return m_from; }
+            void from(sqf::runtime::scalar_t value) { m_from = value; }
+            sqf::runtime::scalar_t to() const { return m_to; }
+            void to(sqf::runtime::scalar_t value) { m_to = value; }
+            sqf::runtime::scalar_t step() const { return m_step; }
+            void step(sqf::runtime::scalar_t value) { m_step = value; }
         };
     }
 
@@ -64,7 +64,7 @@ namespace
         {
             runtime.__logmsg(err::ExpectedNonNullValue(runtime.context_active().current_frame().diag_info_from_position()));
             runtime.__logmsg(err::ReturningEmptyString(runtime.context_active().current_frame().diag_info_from_position()));
-            return std::make_shared<d_array>();
+            return sqf::runtime::make_pooled<d_array>();
         }
         else
         {
@@ -78,7 +78,7 @@ namespace
         {
             runtime.__logmsg(err::ExpectedNonNullValue(runtime.context_active().current_frame().diag_info_from_position()));
             runtime.__logmsg(err::ReturningEmptyString(runtime.context_active().current_frame().diag_info_from_position()));
-            return std::make_shared<d_array>();
+            return sqf::runtime::make_pooled<d_array>();
         }
         else if (grp->value()->empty())
         {
@@ -139,15 +139,15 @@ namespace
         {
             runtime.__logmsg(err::ExpectedNonNullValue(runtime.context_active().current_frame().diag_info_from_position()));
             runtime.__logmsg(err::ReturningEmptyArray(runtime.context_active().current_frame().diag_info_from_position()));
-            return std::make_shared<d_array>();
+            return sqf::runtime::make_pooled<d_array>();
         }
         auto scope = std::static_pointer_cast<value_scope>(grp->value());
 
         std::vector<value> variable_names;
 
-        for (auto& kvp : *scope)
+        for (auto& kvp : scope->variables())
         {
-            variable_names.push_back(kvp.first);
+            variable_names.push_back(kvp.first.name());
         }
         return variable_names;
     }
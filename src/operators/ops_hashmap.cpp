@@ -129,7 +129,7 @@ namespace
         {
             keys.push_back(it.first);
         }
-        return std::make_shared<d_array>(keys);
+        return sqf::runtime::make_pooled<d_array>(keys);
     }
     value plus_hashmap(runtime& runtime, value::cref right)
     {
@@ -34,8 +34,7 @@ namespace
         auto l = left.data<d_boolean, bool>();
         if (l)
         {
-            frame f(runtime.default_value_scope(), right.data<d_code, instruction_set>());
-            runtime.context_active().push_frame(f);
+            runtime.context_active().emplace_frame(runtime.default_value_scope(), right.data<d_code, instruction_set>());
             return {};
         }
         else
@@ -52,43 +51,42 @@ namespace
         }
         else
         {
-            frame f(runtime.default_value_scope(), right.data<d_code, instruction_set>());
-            runtime.context_active().push_frame(f);
+            runtime.context_active().emplace_frame(runtime.default_value_scope(), right.data<d_code, instruction_set>());
             return {};
         }
     }
 
     value greaterthen_scalar_scalar(runtime& runtime, value::cref left, value::cref right)
     {
-        auto l = left.data<d_scalar, float>();
-        auto r = right.data<d_scalar, float>();
+        auto l = left.data<d_scalar, sqf::runtime::scalar_t>();
+        auto r = right.data<d_scalar, sqf::runtime::scalar_t>();
         return l > r;
     }
     value greaterthenorequal_scalar_scalar(runtime& runtime, value::cref left, value::cref right)
     {
-        auto l = left.data<d_scalar, float>();
-        auto r = right.data<d_scalar, float>();
+        auto l = left.data<d_scalar, sqf::runtime::scalar_t>();
+        auto r = right.data<d_scalar, sqf::runtime::scalar_t>();
         return l >= r;
     }
     value lessthen_scalar_scalar(runtime& runtime, value::cref left, value::cref right)
     {
-        auto l = left.data<d_scalar, float>();
-        auto r = right.data<d_scalar, float>();
+        auto l = left.data<d_scalar, sqf::runtime::scalar_t>();
+        auto r = right.data<d_scalar, sqf::runtime::scalar_t>();
         return l < r;
     }
     value lessthenorequal_scalar_scalar(runtime& runtime, value::cref left, value::cref right)
     {
-        auto l = left.data<d_scalar, float>();
-        auto r = right.data<d_scalar, float>();
+        auto l = left.data<d_scalar, sqf::runtime::scalar_t>();
+        auto r = right.data<d_scalar, sqf::runtime::scalar_t>();
         return l <= r;
     }
     value equals_any_any(runtime& runtime, value::cref left, value::cref right)
     {
-        return left.data()->equals(right.data(), true);
+        return left.equals(right, true);
     }
     value notequals_any_any(runtime& runtime, value::cref left, value::cref right)
     {
-        return !left.data()->equals(right.data(), true);
+        return !left.equals(right, true);
     }
     value isequalto_any_any(runtime& runtime, value::cref left, value::cref right)
     {
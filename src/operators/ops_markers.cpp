@@ -51,7 +51,7 @@ namespace
         }
         auto& marker = runtime.storage<sqf::operators::markers_storage>().at(name);
         auto size = marker.get_size();
-        return std::make_shared<d_array>(size.begin(), size.end());
+        return sqf::runtime::make_pooled<d_array>(size.begin(), size.end());
     }
     value getmarkercolor_string(runtime& runtime, value::cref right)
     {
@@ -76,7 +76,7 @@ namespace
         }
         auto& marker = runtime.storage<sqf::operators::markers_storage>().at(name);
         auto pos = marker.get_pos();
-        return std::make_shared<d_array>(pos.begin(), pos.end());
+        return sqf::runtime::make_pooled<d_array>(pos.begin(), pos.end());
     }
     value markerbrush_string(runtime& runtime, value::cref right)
     {
@@ -141,7 +141,7 @@ namespace
     value createmarker_array(runtime& runtime, value::cref right)
     {
         auto arr = right.data<d_array>();
-        std::array<float, 3> pos {0, 0, 0};
+        std::array<sqf::runtime::scalar_t, 3> pos {0, 0, 0};
         std::string name;
         if (arr->check_type(runtime, std::array<type, 2> { t_string(), t_object()}))
         {
@@ -155,17 +155,17 @@ namespace
             }
             auto obj = objdata->value();
             auto tmp = obj->position();
-            pos = std::array<float, 3> { static_cast<float>(tmp.x), static_cast<float>(tmp.y), static_cast<float>(tmp.z)};
+            pos = std::array<sqf::runtime::scalar_t, 3> { static_cast<sqf::runtime::scalar_t>(tmp.x), static_cast<sqf::runtime::scalar_t>(tmp.y), static_cast<sqf::runtime::scalar_t>(tmp.z)};
         }
         else if (arr->check_type(runtime, std::array<type, 2> { t_string(), t_array() }))
         {
             name = arr->at(0).data<d_string, std::string>();
             auto tmpArr = arr->at(1).data<d_array>();
-            pos = std::array<float, 3>
+            pos = std::array<sqf::runtime::scalar_t, 3>
             {
-                tmpArr->at(0).data<d_scalar, float>(),
-                tmpArr->at(1).data<d_scalar, float>(),
-                tmpArr->size() > 2 ? tmpArr->at(2).data<d_scalar, float>() : 0
+                tmpArr->at(0).data<d_scalar, sqf::runtime::scalar_t>(),
+                tmpArr->at(1).data<d_scalar, sqf::runtime::scalar_t>(),
+                tmpArr->size() > 2 ? tmpArr->at(2).data<d_scalar, sqf::runtime::scalar_t>() : 0
             };
             if (!arr->check_type(runtime, t_scalar(), 2, 3))
             {
@@ -274,7 +274,7 @@ namespace
         {
             return {};
         }
-        marker.set_pos(std::array<float, 3>{ arr->at(0).data<d_scalar, float>(), arr->at(1).data<d_scalar, float>(), arr->size() > 2 ? arr->at(2).data<d_scalar, float>() : 0 });
+        marker.set_pos(std::array<sqf::runtime::scalar_t, 3>{ arr->at(0).data<d_scalar, sqf::runtime::scalar_t>(), arr->at(1).data<d_scalar, sqf::runtime::scalar_t>(), arr->size() > 2 ? arr->at(2).data<d_scalar, sqf::runtime::scalar_t>() : 0 });
         return {};
     }
     value setmarkertype_string_string(runtime& runtime, value::cref left, value::cref right)
@@ -330,7 +330,7 @@ namespace
             return {};
         }
         auto& marker = runtime.storage<sqf::operators::markers_storage>().at(name);
-        auto dir = right.data<d_scalar, float>();
+        auto dir = right.data<d_scalar, sqf::runtime::scalar_t>();
         marker.set_direction(dir);
         return {};
     }
@@ -379,7 +379,7 @@ namespace
         {
             return {};
         }
-        marker.set_size(std::array<float, 2>{ arr->at(0).data<d_scalar, float>(), arr->at(1).data<d_scalar, float>() });
+        marker.set_size(std::array<sqf::runtime::scalar_t, 2>{ arr->at(0).data<d_scalar, sqf::runtime::scalar_t>(), arr->at(1).data<d_scalar, sqf::runtime::scalar_t>() });
         return {};
     }
     value setmarkeralpha_string_scalar(runtime& runtime, value::cref left, value::cref right)
@@ -391,7 +391,7 @@ namespace
             return {};
         }
         auto& marker = runtime.storage<sqf::operators::markers_storage>().at(name);
-        auto alpha = right.data<d_scalar, float>();
+        auto alpha = right.data<d_scalar, sqf::runtime::scalar_t>();
         marker.set_alpha(alpha);
         return {};
     }
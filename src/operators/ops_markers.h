@@ -33,10 +33,10 @@ namespace sqf
                 std::string mtype;
                 std::string mcolor;
                 std::string mbrush;
-                std::array<float, 2> msize;
-                std::array<float, 3> mpos;
-                float malpha;
-                float mdirection;
+                std::array<sqf::runtime::scalar_t, 2> msize;
+                std::array<sqf::runtime::scalar_t, 3> mpos;
+                sqf::runtime::scalar_t malpha;
+                sqf::runtime::scalar_t mdirection;
                 shape mshape;
 
             public:
@@ -54,17 +54,17 @@ namespace sqf
                 std::string get_color() const { return mcolor; };
                 void set_color(std::string val) { mcolor = val; };
 
-                std::array<float, 2> get_size() const { return msize; };
-                void set_size(std::array<float, 2> val) { msize = val; };
+                std::array<sqf::runtime::scalar_t, 2> get_size() const { return msize; };
+                void set_size(std::array<sqf::runtime::scalar_t, 2> val) { msize = val; };
 
-                std::array<float, 3> get_pos() const { return mpos; };
-                void set_pos(std::array<float, 3> val) { mpos = val; };
+                std::array<sqf::runtime::scalar_t, 3> get_pos() const { return mpos; };
+                void set_pos(std::array<sqf::runtime::scalar_t, 3> val) { mpos = val; };
 
-                float get_alpha() const { return malpha; };
-                void set_alpha(float val) { malpha = val; };
+                sqf::runtime::scalar_t get_alpha() const { return malpha; };
+                void set_alpha(sqf::runtime::scalar_t val) { malpha = val; };
 
-                float get_direction() const { return mdirection; };
-                void set_direction(float val) { mdirection = val; };
+                sqf::runtime::scalar_t get_direction() const { return mdirection; };
+                void set_direction(sqf::runtime::scalar_t val) { mdirection = val; };
 
                 shape get_shape() const { return mshape; };
                 std::string get_shape_string() const
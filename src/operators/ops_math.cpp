@@ -22,51 +22,51 @@ using namespace sqf::types;
 
 namespace
 {
-	inline float rad(float f) {
-		return (float)(f * util::pi() / 180.0);
+	inline scalar_t rad(scalar_t f) {
+		return (scalar_t)(f * util::pi() / 180.0);
 	}
-	inline float deg(float f) {
-		return (float)(f * 180.0 / util::pi());
+	inline scalar_t deg(scalar_t f) {
+		return (scalar_t)(f * 180.0 / util::pi());
 	}
 	value plus_scalar_scalar(runtime& runtime, value::cref left, value::cref right)
 	{
-		return (left.data<d_scalar, float>()) + (right.data<d_scalar, float>());
+		return (left.data<d_scalar, scalar_t>()) + (right.data<d_scalar, scalar_t>());
 	}
 	value minus_scalar_scalar(runtime& runtime, value::cref left, value::cref right)
 	{
-		return (left.data<d_scalar, float>()) - (right.data<d_scalar, float>());
+		return (left.data<d_scalar, scalar_t>()) - (right.data<d_scalar, scalar_t>());
 	}
 	value multiply_scalar_scalar(runtime& runtime, value::cref left, value::cref right)
 	{
-		return (left.data<d_scalar, float>()) * (right.data<d_scalar, float>());
+		return (left.data<d_scalar, scalar_t>()) * (right.data<d_scalar, scalar_t>());
 	}
 	value divide_scalar_scalar(runtime& runtime, value::cref left, value::cref right)
 	{
-		auto r = (right.data<d_scalar, float>());
-		auto r_is_rero = std::abs(r) <= std::numeric_limits<float>::epsilon();
+		auto r = (right.data<d_scalar, scalar_t>());
+		auto r_is_rero = std::abs(r) <= std::numeric_limits<scalar_t>::epsilon();
 		if (r_is_rero)
 		{
 			runtime.__logmsg(err::ZeroDivisor(runtime.context_active().current_frame().diag_info_from_position()));
 			return 0;
 		}
-		return (left.data<d_scalar, float>()) / r;
+		return (left.data<d_scalar, scalar_t>()) / r;
 	}
 	value abs_scalar(runtime& runtime, value::cref right)
 	{
-		auto r = right.data<d_scalar, float>();
+		auto r = right.data<d_scalar, scalar_t>();
 		return std::fabs(r);
 	}
 	value atan2_scalar_scalar(runtime& runtime, value::cref left, value::cref right)
 	{
-		return deg(std::atan2(rad(left.data<d_scalar, float>()), rad(right.data<d_scalar, float>())));
+		return deg(std::atan2(rad(left.data<d_scalar, scalar_t>()), rad(right.data<d_scalar, scalar_t>())));
 	}
 	value deg_scalar(runtime& runtime, value::cref right)
 	{
-		return deg(right.data<d_scalar, float>());
+		return deg(right.data<d_scalar, scalar_t>());
 	}
     value log_scalar(runtime& runtime, value::cref right)
 	{
-		return std::log10(right.data<d_scalar, float>());
+		return std::log10(right.data<d_scalar, scalar_t>());
 	}
 	value pi_(runtime& runtime)
 	{
@@ -74,88 +74,88 @@ namespace
 	}
 	value sin_scalar(runtime& runtime, value::cref right)
 	{
-		return std::sin(rad(right.data<d_scalar, float>()));
+		return std::sin(rad(right.data<d_scalar, scalar_t>()));
 	}
 	value acos_scalar(runtime& runtime, value::cref right)
 	{
-		return deg(std::acos(right.data<d_scalar, float>()));
+		return deg(std::acos(right.data<d_scalar, scalar_t>()));
 	}
 	value exp_scalar(runtime& runtime, value::cref right)
 	{
-		return std::exp(right.data<d_scalar, float>());
+		return std::exp(right.data<d_scalar, scalar_t>());
 	}
     value rad_scalar(runtime& runtime, value::cref right)
 	{
-		return rad(right.data<d_scalar, float>());
+		return rad(right.data<d_scalar, scalar_t>());
 	}
 	value sqrt_scalar(runtime& runtime, value::cref right)
 	{
-		return std::sqrt(right.data<d_scalar, float>());
+		return std::sqrt(right.data<d_scalar, scalar_t>());
 	}
 	value tan_scalar(runtime& runtime, value::cref right)
 	{
-		return std::tan(rad(right.data<d_scalar, float>()));
+		return std::tan(rad(right.data<d_scalar, scalar_t>()));
 	}
     value random_scalar(runtime& runtime, value::cref right)
 	{
-		return (static_cast<float>(std::rand()) / RAND_MAX) * right.data<d_scalar, float>();
+		return (static_cast<scalar_t>(std::rand()) / RAND_MAX) * right.data<d_scalar, scalar_t>();
 	}
 	value min_scalar_scalar(runtime& runtime, value::cref left, value::cref right)
 	{
-		auto l = left.data<d_scalar, float>();
-		auto r = right.data<d_scalar, float>();
+		auto l = left.data<d_scalar, scalar_t>();
+		auto r = right.data<d_scalar, scalar_t>();
 		return std::fmin(l, r);
 	}
 	value max_scalar_scalar(runtime& runtime, value::cref left, value::cref right)
 	{
-		auto l = left.data<d_scalar, float>();
-		auto r = right.data<d_scalar, float>();
+		auto l = left.data<d_scalar, scalar_t>();
+		auto r = right.data<d_scalar, scalar_t>();
 		return std::fmax(l, r);
 	}
 	value floor_scalar(runtime& runtime, value::cref right)
 	{
-		auto r = right.data<d_scalar, float>();
+		auto r = right.data<d_scalar, scalar_t>();
 		return std::floor(r);
 	}
 	value ceil_scalar(runtime& runtime, value::cref right)
 	{
-		auto r = right.data<d_scalar, float>();
+		auto r = right.data<d_scalar, scalar_t>();
 		return std::ceil(r);
 	}
 	value asin_scalar(runtime& runtime, value::cref right)
 	{
-		auto r = right.data<d_scalar, float>();
+		auto r = right.data<d_scalar, scalar_t>();
 		return deg(std::asin(r));
 	}
 	value atan_scalar(runtime& runtime, value::cref right)
 	{
-		auto r = right.data<d_scalar, float>();
+		auto r = right.data<d_scalar, scalar_t>();
 		return deg(std::atan(r));
 	}
 	value cos_scalar(runtime& runtime, value::cref right)
 	{
-		auto r = right.data<d_scalar, float>();
+		auto r = right.data<d_scalar, scalar_t>();
 		return std::cos(rad(r));
 	}
     value ln_scalar(runtime& runtime, value::cref right)
 	{
-		auto r = right.data<d_scalar, float>();
+		auto r = right.data<d_scalar, scalar_t>();
 		return std::log(r);
 	}
 	value mod_scalar_scalar(runtime& runtime, value::cref left, value::cref right)
 	{
-		auto l = left.data<d_scalar, float>();
-		auto r = right.data<d_scalar, float>();
+		auto l = left.data<d_scalar, scalar_t>();
+		auto r = right.data<d_scalar, scalar_t>();
 		return std::fmod(l, r);
 	}
     value round_scalar(runtime& runtime, value::cref right)
 	{
-		auto r = right.data<d_scalar, float>();
+		auto r = right.data<d_scalar, scalar_t>();
 		return std::round(r);
 	}
 	value minus_scalar(runtime& runtime, value::cref right)
 	{
-		auto r = right.data<d_scalar, float>();
+		auto r = right.data<d_scalar, scalar_t>();
 		return -r;
 	}
 	value exclamationmark_bool(runtime& runtime, value::cref right)
@@ -165,8 +165,8 @@ namespace
 	}
     value raisetopower_scalar_scalar(runtime& runtime, value::cref left, value::cref right)
 	{
-		auto l = left.data<d_scalar, float>();
-		auto r = right.data<d_scalar, float>();
+		auto l = left.data<d_scalar, scalar_t>();
+		auto r = right.data<d_scalar, scalar_t>();
 		return std::pow(l, r);
 	}
 	value plus_scalar(runtime& runtime, value::cref right)
@@ -180,10 +180,10 @@ namespace
 
 		// Check that neither rows nor first col is empty
 		if (l->size() == 0 || l->at(0).type() != t_array() || l->at(0).data<d_array>()->size() == 0) {
-			return std::make_shared<d_array>();
+			return sqf::runtime::make_pooled<d_array>();
 		}
 		if (r->size() == 0 || r->at(0).type() != t_array() || r->at(0).data<d_array>()->size() == 0) {
-			return std::make_shared<d_array>();
+			return sqf::runtime::make_pooled<d_array>();
 		}
 
 		size_t l_rows = l->size();
@@ -194,31 +194,31 @@ namespace
 		// Check that array is n x k
 		for (size_t i = 1; i < l_rows; i++) {
 			if (l->at(i).data<d_array>()->size() != l_cols) {
-				return std::make_shared<d_array>();
+				return sqf::runtime::make_pooled<d_array>();
 			}
 		}
 
 		// Check that array is k x m
 		for (size_t i = 1; i < r_rows; i++) {
 			if (r->at(i).data<d_array>()->size() != r_cols) {
-				return std::make_shared<d_array>();
+				return sqf::runtime::make_pooled<d_array>();
 			}
 		}
 
 		// Ensure arrays are n x k and k x m
 		if (l_cols != r_rows) {
-			return std::make_shared<d_array>();
+			return sqf::runtime::make_pooled<d_array>();
 		}
 
-		auto multiplied = std::make_shared<d_array>();
+		auto multiplied = sqf::runtime::make_pooled<d_array>();
 
 		for (size_t i = 0; i < l_rows; i++) {
-			auto row = std::make_shared<d_array>();
+			auto row = sqf::runtime::make_pooled<d_array>();
 			for (size_t j = 0; j < r_cols; j++) {
-				float col = 0;
+				scalar_t col = 0;
 				for (size_t k = 0; k < r_rows; k++) {
-					auto l_value = l->at(i).data<d_array>()->at(k).data<d_scalar, float>();
-					auto r_value = r->at(k).data<d_array>()->at(j).data<d_scalar, float>();
+					auto l_value = l->at(i).data<d_array>()->at(k).data<d_scalar, scalar_t>();
+					auto r_value = r->at(k).data<d_array>()->at(j).data<d_scalar, scalar_t>();
 					col = col + l_value * r_value;
 				}
 				row->push_back(col);
@@ -234,7 +234,7 @@ namespace
 
 		// Check that neither rows nor first col is empty
 		if (l->size() == 0 || l->at(0).type() != t_array() || l->at(0).data<d_array>()->size() == 0) {
-			return std::make_shared<d_array>();
+			return sqf::runtime::make_pooled<d_array>();
 		}
 
 		auto row_size = l->size();
@@ -243,39 +243,39 @@ namespace
 		// Check that array is n x k
 		for (size_t i = 1; i < row_size; i++) {
 			if (l->at(i).data<d_array>()->size() != col_size) {
-				return std::make_shared<d_array>();
+				return sqf::runtime::make_pooled<d_array>();
 			}
 		}
 
-		auto transposed = std::make_shared<d_array>();
+		auto transposed = sqf::runtime::make_pooled<d_array>();
 
 		for (size_t i = 0; i < col_size; i++) {
-			auto row = std::make_shared<d_array>();
+			auto row = sqf::runtime::make_pooled<d_array>();
 			for (size_t j = 0; j < row_size; j++) {
-				row->push_back(l->at(j).data<d_array>()->at(i).data<d_scalar, float>());
+				row->push_back(l->at(j).data<d_array>()->at(i).data<d_scalar, scalar_t>());
 			}
 			transposed->push_back(row);
 		}
 
 		return transposed;
 	}
-	float dotProduct(vec3 left, vec3 right)
+	scalar_t dotProduct(vec3 left, vec3 right)
 	{
 		return left.x * right.x + left.y * right.y + left.z * right.z;
 	}
-	float vectorMagnitudeSqr(vec3 arr)
+	scalar_t vectorMagnitudeSqr(vec3 arr)
 	{
-		return (float)(std::pow(arr.x, 2) + std::pow(arr.y, 2) + std::pow(arr.z, 2));
+		return (scalar_t)(std::pow(arr.x, 2) + std::pow(arr.y, 2) + std::pow(arr.z, 2));
 	}
-	float vectorMagnitude(vec3 arr)
+	scalar_t vectorMagnitude(vec3 arr)
 	{
 		return std::sqrt(vectorMagnitudeSqr(arr));
 	}
-	float vectorDistanceSqr(vec3 left, vec3 right)
+	scalar_t vectorDistanceSqr(vec3 left, vec3 right)
 	{
-		return (float)(std::pow(left.x - right.x, 2) + std::pow(left.y - right.y, 2) + std::pow(left.z - right.z, 2));
+		return (scalar_t)(std::pow(left.x - right.x, 2) + std::pow(left.y - right.y, 2) + std::pow(left.z - right.z, 2));
 	}
-	float vectorDistance(vec3 left, vec3 right)
+	scalar_t vectorDistance(vec3 left, vec3 right)
 	{
 		return std::sqrt(vectorDistanceSqr(left, right));
 	}
@@ -283,21 +283,21 @@ namespace
 	{
 		auto l = left.data<d_array>();
 		auto r = right.data<d_array>();
-		auto arr = std::make_shared<d_array>();
+		auto arr = sqf::runtime::make_pooled<d_array>();
 		if (!l->check_type(runtime, t_scalar(), 3) || !r->check_type(runtime, t_scalar(), 3))
 		{
 			return {};
 		}
-		arr->push_back(l->at(0).data<d_scalar, float>() + r->at(0).data<d_scalar, float>());
-		arr->push_back(l->at(1).data<d_scalar, float>() + r->at(1).data<d_scalar, float>());
-		arr->push_back(l->at(2).data<d_scalar, float>() + r->at(2).data<d_scalar, float>());
+		arr->push_back(l->at(0).data<d_scalar, scalar_t>() + r->at(0).data<d_scalar, scalar_t>());
+		arr->push_back(l->at(1).data<d_scalar, scalar_t>() + r->at(1).data<d_scalar, scalar_t>());
+		arr->push_back(l->at(2).data<d_scalar, scalar_t>() + r->at(2).data<d_scalar, scalar_t>());
 		return value(arr);
 	}
 	value vectorcos_array_array(runtime& runtime, value::cref left, value::cref right)
 	{
 		auto l = left.data<d_array>();
 		auto r = right.data<d_array>();
-		auto arr = std::make_shared<d_array>();
+		auto arr = sqf::runtime::make_pooled<d_array>();
 		if (!l->check_type(runtime, t_scalar(), 3) || !r->check_type(runtime, t_scalar(), 3))
 		{
 			return {};
@@ -308,21 +308,21 @@ namespace
 	{
 		auto l = left.data<d_array>();
 		auto r = right.data<d_array>();
-		auto arr = std::make_shared<d_array>();
+		auto arr = sqf::runtime::make_pooled<d_array>();
 		if (!l->check_type(runtime, t_scalar(), 3) || !r->check_type(runtime, t_scalar(), 3))
 		{
 			return {};
 		}
-		arr->push_back(l->at(1).data<d_scalar, float>() * r->at(2).data<d_scalar, float>() - l->at(2).data<d_scalar, float>() * r->at(1).data<d_scalar, float>());
-		arr->push_back(l->at(2).data<d_scalar, float>() * r->at(0).data<d_scalar, float>() - l->at(0).data<d_scalar, float>() * r->at(2).data<d_scalar, float>());
-		arr->push_back(l->at(0).data<d_scalar, float>() * r->at(1).data<d_scalar, float>() - l->at(1).data<d_scalar, float>() * r->at(0).data<d_scalar, float>());
+		arr->push_back(l->at(1).data<d_scalar, scalar_t>() * r->at(2).data<d_scalar, scalar_t>() - l->at(2).data<d_scalar, scalar_t>() * r->at(1).data<d_scalar, scalar_t>());
+		arr->push_back(l->at(2).data<d_scalar, scalar_t>() * r->at(0).data<d_scalar, scalar_t>() - l->at(0).data<d_scalar, scalar_t>() * r->at(2).data<d_scalar, scalar_t>());
+		arr->push_back(l->at(0).data<d_scalar, scalar_t>() * r->at(1).data<d_scalar, scalar_t>() - l->at(1).data<d_scalar, scalar_t>() * r->at(0).data<d_scalar, scalar_t>());
 		return value(arr);
 	}
 	value vectordistance_array_array(runtime& runtime, value::cref left, value::cref right)
 	{
 		auto l = left.data<d_array>();
 		auto r = right.data<d_array>();
-		auto arr = std::make_shared<d_array>();
+		auto arr = sqf::runtime::make_pooled<d_array>();
 		if (!l->check_type(runtime, t_scalar(), 3) || !r->check_type(runtime, t_scalar(), 3))
 		{
 			return {};
@@ -333,7 +333,7 @@ namespace
 	{
 		auto l = left.data<d_array>();
 		auto r = right.data<d_array>();
-		auto arr = std::make_shared<d_array>();
+		auto arr = sqf::runtime::make_pooled<d_array>();
 		if (!l->check_type(runtime, t_scalar(), 3) || !r->check_type(runtime, t_scalar(), 3))
 		{
 			return {};
@@ -343,29 +343,29 @@ namespace
 	value vectormultiply_array_scalar(runtime& runtime, value::cref left, value::cref right)
 	{
 		auto l = left.data<d_array>();
-		auto r = right.data<d_scalar, float>();
-		auto arr = std::make_shared<d_array>();
+		auto r = right.data<d_scalar, scalar_t>();
+		auto arr = sqf::runtime::make_pooled<d_array>();
 		if (!l->check_type(runtime, t_scalar(), 3))
 		{
 			return {};
 		}
-		arr->push_back(l->at(0).data<d_scalar, float>() * r);
-		arr->push_back(l->at(1).data<d_scalar, float>() * r);
-		arr->push_back(l->at(2).data<d_scalar, float>() * r);
+		arr->push_back(l->at(0).data<d_scalar, scalar_t>() * r);
+		arr->push_back(l->at(1).data<d_scalar, scalar_t>() * r);
+		arr->push_back(l->at(2).data<d_scalar, scalar_t>() * r);
 		return value(arr);
 	}
 	value vectordiff_array_array(runtime& runtime, value::cref left, value::cref right)
 	{
 		auto l = left.data<d_array>();
 		auto r = right.data<d_array>();
-		auto arr = std::make_shared<d_array>();
+		auto arr = sqf::runtime::make_pooled<d_array>();
 		if (!l->check_type(runtime, t_scalar(), 3) || !r->check_type(runtime, t_scalar(), 3))
 		{
 			return {};
 		}
-		arr->push_back(l->at(0).data<d_scalar, float>() - r->at(0).data<d_scalar, float>());
-		arr->push_back(l->at(1).data<d_scalar, float>() - r->at(1).data<d_scalar, float>());
-		arr->push_back(l->at(2).data<d_scalar, float>() - r->at(2).data<d_scalar, float>());
+		arr->push_back(l->at(0).data<d_scalar, scalar_t>() - r->at(0).data<d_scalar, scalar_t>());
+		arr->push_back(l->at(1).data<d_scalar, scalar_t>() - r->at(1).data<d_scalar, scalar_t>());
+		arr->push_back(l->at(2).data<d_scalar, scalar_t>() - r->at(2).data<d_scalar, scalar_t>());
 		return value(arr);
 	}
 	value vectordotproduct_array_array(runtime& runtime, value::cref left, value::cref right)
@@ -399,7 +399,7 @@ namespace
 	value vectornormalized_array(runtime& runtime, value::cref left)
 	{
 		auto l = left.data<d_array>();
-		auto arr = std::make_shared<d_array>();
+		auto arr = sqf::runtime::make_pooled<d_array>();
 		if (!l->check_type(runtime, t_scalar(), 3))
 		{
 			return {};
@@ -413,9 +413,9 @@ namespace
 		}
 		else
 		{
-			arr->push_back(l->at(0).data<d_scalar, float>() / magnitude);
-			arr->push_back(l->at(1).data<d_scalar, float>() / magnitude);
-			arr->push_back(l->at(2).data<d_scalar, float>() / magnitude);
+			arr->push_back(l->at(0).data<d_scalar, scalar_t>() / magnitude);
+			arr->push_back(l->at(1).data<d_scalar, scalar_t>() / magnitude);
+			arr->push_back(l->at(2).data<d_scalar, scalar_t>() / magnitude);
 		}
 		return value(arr);
 	}
@@ -430,7 +430,7 @@ namespace
 		{
 			i = -1;
 		}
-		sqf::types::d_scalar::set_decimals(i);
+		runtime.scalar_decimals(i);
 		return {};
 	}
 	value tofixed_scalar_scalar(runtime& runtime, value::cref left, value::cref right)
@@ -445,7 +445,7 @@ namespace
 			i = 0;
 		}
 		std::stringstream sstream;
-		sstream << std::fixed << std::setprecision(i) << left.data<d_scalar, float>();
+		sstream << std::fixed << std::setprecision(i) << left.data<d_scalar, scalar_t>();
         return sstream.str();
 	}
 }
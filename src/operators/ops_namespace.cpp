@@ -25,9 +25,9 @@ namespace
         auto scope = right.data<d_namespace, std::shared_ptr<value_scope>>();
         std::vector<value> variable_names;
 
-        for (auto& kvp : *scope)
+        for (auto& kvp : scope->variables())
         {
-            variable_names.push_back(kvp.first);
+            variable_names.push_back(kvp.first.name());
         }
         return variable_names;
     }
@@ -42,7 +42,7 @@ namespace
         auto set = right.data<d_code, instruction_set>();
 
         frame f(scope, set);
-        runtime.context_active().push_frame(f);
+        runtime.context_active().push_frame(std::move(f));
         return {};
     }
     value getVariable_namespace_string(runtime& runtime, value::cref left, value::cref right)
@@ -65,7 +65,7 @@ namespace
         {
             return {};
         }
-        auto radius = arr->at(3).data<d_scalar, float>();
+        auto radius = arr->at(3).data<d_scalar, sqf::runtime::scalar_t>();
         config conf;
         if (runtime.configuration().enable_classname_check)
         {
@@ -91,9 +91,9 @@ namespace
         }
         auto veh = object::create(runtime, conf, true);
         veh->position({
-            position->at(0).data<d_scalar, float>() + ((std::rand() % static_cast<int>(radius * 2)) - radius),
-            position->at(1).data<d_scalar, float>() + ((std::rand() % static_cast<int>(radius * 2)) - radius),
-            position->at(2).data<d_scalar, float>()
+            position->at(0).data<d_scalar, sqf::runtime::scalar_t>() + ((std::rand() % static_cast<int>(radius * 2)) - radius),
+            position->at(1).data<d_scalar, sqf::runtime::scalar_t>() + ((std::rand() % static_cast<int>(radius * 2)) - radius),
+            position->at(2).data<d_scalar, sqf::runtime::scalar_t>()
             });
         return std::make_shared<d_object>(veh);
     }
@@ -134,9 +134,9 @@ namespace
         }
         auto veh = object::create(runtime, conf, true);
         veh->position({
-            position->at(0).data<d_scalar, float>(),
-            position->at(1).data<d_scalar, float>(),
-            position->at(2).data<d_scalar, float>()
+            position->at(0).data<d_scalar, sqf::runtime::scalar_t>(),
+            position->at(1).data<d_scalar, sqf::runtime::scalar_t>(),
+            position->at(2).data<d_scalar, sqf::runtime::scalar_t>()
             });
         return std::make_shared<d_object>(veh);
     }
@@ -161,7 +161,7 @@ namespace
             return {};
         }
         auto pos = veh->value()->position();
-        auto arr = std::make_shared<d_array>();
+        auto arr = sqf::runtime::make_pooled<d_array>();
         arr->push_back(pos.x);
         arr->push_back(pos.y);
         arr->push_back(pos.z);
@@ -179,9 +179,9 @@ namespace
         position->check_type(runtime, t_scalar(), 3);
         auto inner = veh->value();
         inner->position({
-            position->at(0).data<d_scalar, float>(),
-            position->at(1).data<d_scalar, float>(),
-            position->at(2).data<d_scalar, float>()
+            position->at(0).data<d_scalar, sqf::runtime::scalar_t>(),
+            position->at(1).data<d_scalar, sqf::runtime::scalar_t>(),
+            position->at(2).data<d_scalar, sqf::runtime::scalar_t>()
             });
         return {};
     }
@@ -194,7 +194,7 @@ namespace
             return {};
         }
         auto vel = veh->value()->velocity();
-        auto arr = std::make_shared<d_array>();
+        auto arr = sqf::runtime::make_pooled<d_array>();
         arr->push_back(vel.x);
         arr->push_back(vel.y);
         arr->push_back(vel.z);
@@ -212,9 +212,9 @@ namespace
         velocity->check_type(runtime, t_scalar(), 3);
         auto inner = veh->value();
         inner->velocity({
-            velocity->at(0).data<d_scalar, float>(),
-            velocity->at(1).data<d_scalar, float>(),
-            velocity->at(2).data<d_scalar, float>()
+            velocity->at(0).data<d_scalar, sqf::runtime::scalar_t>(),
+            velocity->at(1).data<d_scalar, sqf::runtime::scalar_t>(),
+            velocity->at(2).data<d_scalar, sqf::runtime::scalar_t>()
             });
         return {};
     }
@@ -272,7 +272,7 @@ namespace
         {
             return {};
         }
-        auto radius = arr->at(3).data<d_scalar, float>();
+        auto radius = arr->at(3).data<d_scalar, sqf::runtime::scalar_t>();
         config conf;
         if (runtime.configuration().enable_classname_check)
         {
@@ -298,9 +298,9 @@ namespace
         }
         auto veh = object::create(runtime, conf, false);
         veh->position({
-            position->at(0).data<d_scalar, float>() + ((std::rand() % static_cast<int>(radius * 2)) - radius),
-            position->at(1).data<d_scalar, float>() + ((std::rand() % static_cast<int>(radius * 2)) - radius),
-            position->at(2).data<d_scalar, float>()
+            position->at(0).data<d_scalar, sqf::runtime::scalar_t>() + ((std::rand() % static_cast<int>(radius * 2)) - radius),
+            position->at(1).data<d_scalar, sqf::runtime::scalar_t>() + ((std::rand() % static_cast<int>(radius * 2)) - radius),
+            position->at(2).data<d_scalar, sqf::runtime::scalar_t>()
             });
         return std::make_shared<d_object>(veh);
     }
@@ -359,7 +359,7 @@ namespace
             }
             else
             {
-                skill = arr->at(3).data<d_scalar, float>();
+                skill = arr->at(3).data<d_scalar, sqf::runtime::scalar_t>();
             }
         }
         //rank
@@ -406,9 +406,9 @@ namespace
         }
 
         veh->position({
-            position->at(0).data<d_scalar, float>(),
-            position->at(1).data<d_scalar, float>(),
-            position->at(2).data<d_scalar, float>()
+            position->at(0).data<d_scalar, sqf::runtime::scalar_t>(),
+            position->at(1).data<d_scalar, sqf::runtime::scalar_t>(),
+            position->at(2).data<d_scalar, sqf::runtime::scalar_t>()
             });
         return obj;
     }
@@ -526,17 +526,17 @@ namespace
     }
     class nearestobjects_distancesort3d
     {
-        std::array<float, 3> pos;
+        std::array<sqf::runtime::scalar_t, 3> pos;
     public:
-        nearestobjects_distancesort3d(std::array<float, 3> p) : pos(p) {}
+        nearestobjects_distancesort3d(std::array<sqf::runtime::scalar_t, 3> p) : pos(p) {}
         nearestobjects_distancesort3d(vec3 p) : pos({ p.x, p.y, p.z }) {}
         bool operator() (value::cref l, value::cref r) const { return l.data<d_object>()->value()->distance3d(pos) < r.data<d_object>()->value()->distance3d(pos); }
     };
     class nearestobjects_distancesort2d
     {
-        std::array<float, 2> pos;
+        std::array<sqf::runtime::scalar_t, 2> pos;
     public:
-        nearestobjects_distancesort2d(std::array<float, 2> p) : pos(p) {}
+        nearestobjects_distancesort2d(std::array<sqf::runtime::scalar_t, 2> p) : pos(p) {}
         nearestobjects_distancesort2d(vec3 p) : pos({ p.x, p.y }) {}
         bool operator() (value::cref l, value::cref r) const { return l.data<d_object>()->value()->distance2d(pos) < r.data<d_object>()->value()->distance2d(pos); }
     };
@@ -590,7 +590,7 @@ namespace
             runtime.__logmsg(err::ExpectedArrayTypeMissmatch(runtime.context_active().current_frame().diag_info_from_position(), 2, t_scalar(), arr->at(2).type()));
             return {};
         }
-        auto radius = arr->at(2).data<d_scalar, float>();
+        auto radius = arr->at(2).data<d_scalar, sqf::runtime::scalar_t>();
         auto is2ddistance = false;
         if (arr->size() == 4)
         {
@@ -601,10 +601,10 @@ namespace
             }
             is2ddistance = arr->at(3).data<d_boolean, bool>();
         }
-        auto outputarr = std::make_shared<d_array>();
+        auto outputarr = sqf::runtime::make_pooled<d_array>();
         if (is2ddistance)
         {
-            std::array<float, 2> position2d{ position.x, position.y };
+            std::array<sqf::runtime::scalar_t, 2> position2d{ position.x, position.y };
             for (auto& object : runtime.storage<object::object_storage>())
             {
                 if (object->distance2d(position2d) > radius) continue;
@@ -685,7 +685,7 @@ namespace
     }
     value allunits_(runtime& runtime)
     {
-        auto arr = std::make_shared<d_array>();
+        auto arr = sqf::runtime::make_pooled<d_array>();
         for (auto& object : runtime.storage<object::object_storage>())
         {
             if (object->is_vehicle())
@@ -767,7 +767,7 @@ namespace
     value setdamage_object_scalar(runtime& runtime, value::cref left, value::cref right)
     {
         auto l = left.data<d_object>();
-        auto r = right.data<d_scalar, float>();
+        auto r = right.data<d_scalar, sqf::runtime::scalar_t>();
         if (l->is_null())
         {
             runtime.__logmsg(err::ExpectedNonNullValue(runtime.context_active().current_frame().diag_info_from_position()));
@@ -804,7 +804,7 @@ namespace
             runtime.__logmsg(err::ExpectedNonNullValue(runtime.context_active().current_frame().diag_info_from_position()));
             return {};
         }
-        auto arr = std::make_shared<d_array>();
+        auto arr = sqf::runtime::make_pooled<d_array>();
         auto obj = r->value();
         if (!obj->is_vehicle())
         {
@@ -981,15 +981,15 @@ namespace
         {
             runtime.__logmsg(err::ExpectedNonNullValueWeak(runtime.context_active().current_frame().diag_info_from_position()));
             runtime.__logmsg(err::ReturningEmptyArray(runtime.context_active().current_frame().diag_info_from_position()));
-            return std::make_shared<d_array>();
+            return sqf::runtime::make_pooled<d_array>();
         }
         auto scope = std::static_pointer_cast<value_scope>(obj->value());
 
         std::vector<value> variable_names;
 
-        for (auto& kvp : *scope)
+        for (auto& kvp : scope->variables())
         {
-            variable_names.push_back(kvp.first);
+            variable_names.push_back(kvp.first.name());
         }
         return variable_names;
     }
@@ -1074,7 +1074,7 @@ namespace
         {
             runtime.__logmsg(err::ExpectedNonNullValueWeak(runtime.context_active().current_frame().diag_info_from_position()));
             runtime.__logmsg(err::ReturningEmptyString(runtime.context_active().current_frame().diag_info_from_position()));
-            return std::make_shared<d_array>();
+            return sqf::runtime::make_pooled<d_array>();
         }
         else
         {
@@ -1083,7 +1083,7 @@ namespace
             {
                 runtime.__logmsg(err::ExpectedNonNullValue(runtime.context_active().current_frame().diag_info_from_position()));
                 runtime.__logmsg(err::ReturningEmptyString(runtime.context_active().current_frame().diag_info_from_position()));
-                return std::make_shared<d_array>();
+                return sqf::runtime::make_pooled<d_array>();
             }
             else
             {
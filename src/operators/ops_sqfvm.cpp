@@ -22,6 +22,11 @@
 #include "d_object.h"
 #include "ops_namespace.h"
 #include "../opcodes/common.h"
+#include "../parser/sqf/sqf_precompiled.hpp"
+#include "../parser/sqf/sqf_parser.hpp"
+#include "../parser/sqf/sqf_optimizer.hpp"
+#include "../parser/assembly/assembly_parser.h"
+#include "../parser/config/config_parser.hpp"
 
 
 #include <sstream>
@@ -155,6 +160,43 @@ namespace
         }
         return std::make_shared<d_code>(code);
     }
+    // Collects the messages of a parser instead of passing them to the runtime logger,
+    // allowing SQF to inspect them (eg. for the position a parser error got reported at).
+    class message_collector : public Logger
+    {
+    public:
+        std::vector<value> messages;
+
+        message_collector() : Logger() {}
+        virtual void log(const LogMessageBase& message) override
+        {
+            messages.emplace_back(message.formatMessage());
+        }
+    };
+    value checksqf___string(runtime& runtime, value::cref right)
+    {
+        auto str = right.data<d_string, std::string>();
+        message_collector collector;
+        sqf::parser::sqf::parser parser(collector);
+        parser.check_syntax(runtime, str, runtime.context_active().current_frame().diag_info_from_position().path());
+        return collector.messages;
+    }
+    value checkassembly___string(runtime& runtime, value::cref right)
+    {
+        auto str = right.data<d_string, std::string>();
+        message_collector collector;
+        sqf::parser::assembly::parser parser(collector);
+        parser.check_syntax(runtime, str, runtime.context_active().current_frame().diag_info_from_position().path());
+        return collector.messages;
+    }
+    value checkconfig___string(runtime& runtime, value::cref right)
+    {
+        auto str = right.data<d_string, std::string>();
+        message_collector collector;
+        sqf::parser::config::parser parser(collector);
+        parser.check_syntax(str, runtime.context_active().current_frame().diag_info_from_position().path());
+        return collector.messages;
+    }
     value assembly___code(runtime& runtime, value::cref right)
     {
         auto code = right.data<d_code>();
@@ -166,10 +208,17 @@ namespace
         }
         return outarr;
     }
+    value optimize___code(runtime& runtime, value::cref right)
+    {
+        auto code = right.data<d_code>();
+        std::vector<sqf::runtime::instruction::sptr> set(code->value().begin(), code->value().end());
+        sqf::parser::sqf::optimize(runtime, set);
+        return std::make_shared<d_code>(set);
+    }
     value assembly___string(runtime& runtime, value::cref right)
     {
         auto str = right.data<d_string>();
-        auto set = runtime.parser_sqf().parse(runtime, *str, runtime.context_active().current_frame().diag_info_from_position().path);
+        auto set = runtime.parser_sqf().parse(runtime, *str, runtime.context_active().current_frame().diag_info_from_position().path());
         if (set.has_value())
         {
             std::vector<value> outarr;
@@ -184,34 +233,56 @@ namespace
             return {};
         }
     }
+    value serialize___code(runtime& runtime, value::cref right)
+    {
+        auto code = right.data<d_code>();
+        auto blob = sqf::parser::sqf::serialize(code->value());
+        if (!blob.has_value())
+        {
+            return {};
+        }
+        return *blob;
+    }
+    value deserialize___string(runtime& runtime, value::cref right)
+    {
+        auto set = sqf::parser::sqf::deserialize(right.data<d_string, std::string>());
+        if (!set.has_value())
+        {
+            return {};
+        }
+        return std::make_shared<d_code>(*set);
+    }
     value cmds___(runtime& runtime)
     {
         std::vector<value> outarr;
         auto str = "n";
-        for (auto pair = runtime.sqfop_nular_begin(); pair != runtime.sqfop_nular_end(); pair++)
+        for (const sqf::runtime::sqfop_nular& op : runtime.sqfop_nular_all())
         {
+            auto key = op.get_key();
             outarr.push_back(std::vector<value> {
                 str,
-                    pair->first.name
+                    key.name
             });
         }
         str = "u";
-        for (auto pair = runtime.sqfop_unary_begin(); pair != runtime.sqfop_unary_end(); pair++)
+        for (const sqf::runtime::sqfop_unary& op : runtime.sqfop_unary_all())
         {
+            auto key = op.get_key();
             outarr.push_back(std::vector<value> {
                 str,
-                    pair->first.name,
-                    pair->first.right_type.to_string()
+                    key.name,
+                    key.right_type.to_string()
             });
         }
         str = "b";
-        for (auto pair = runtime.sqfop_binary_begin(); pair != runtime.sqfop_binary_end(); pair++)
+        for (const sqf::runtime::sqfop_binary& op : runtime.sqfop_binary_all())
         {
+            auto key = op.get_key();
             outarr.push_back(std::vector<value> {
                 str,
-                    pair->first.left_type.to_string(),
-                    pair->first.name,
-                    pair->first.right_type.to_string()
+                    key.left_type.to_string(),
+                    key.name,
+                    key.right_type.to_string()
             });
         }
         return outarr;
@@ -220,36 +291,39 @@ namespace
     {
         std::vector<value> outarr;
         auto str = "n";
-        for (auto pair = runtime.sqfop_nular_begin(); pair != runtime.sqfop_nular_end(); pair++)
+        for (const sqf::runtime::sqfop_nular& op : runtime.sqfop_nular_all())
         {
-            if (pair->second.description().empty())
+            auto key = op.get_key();
+            if (op.description().empty())
                 continue;
             outarr.push_back(std::vector<value> {
                 str,
-                    pair->first.name
+                    key.name
             });
         }
         str = "u";
-        for (auto pair = runtime.sqfop_unary_begin(); pair != runtime.sqfop_unary_end(); pair++)
+        for (const sqf::runtime::sqfop_unary& op : runtime.sqfop_unary_all())
         {
-            if (pair->second.description().empty())
+            auto key = op.get_key();
+            if (op.description().empty())
                 continue;
             outarr.push_back(std::vector<value> {
                 str,
-                    pair->first.name,
-                    pair->first.right_type.to_string()
+                    key.name,
+                    key.right_type.to_string()
             });
         }
         str = "b";
-        for (auto pair = runtime.sqfop_binary_begin(); pair != runtime.sqfop_binary_end(); pair++)
+        for (const sqf::runtime::sqfop_binary& op : runtime.sqfop_binary_all())
         {
-            if (pair->second.description().empty())
+            auto key = op.get_key();
+            if (op.description().empty())
                 continue;
             outarr.push_back(std::vector<value> {
                 str,
-                    pair->first.left_type.to_string(),
-                    pair->first.name,
-                    pair->first.right_type.to_string()
+                    key.left_type.to_string(),
+                    key.name,
+                    key.right_type.to_string()
             });
         }
         return outarr;
@@ -258,36 +332,39 @@ namespace
     {
         std::vector<value> outarr;
         auto str = "n";
-        for (auto pair = runtime.sqfop_nular_begin(); pair != runtime.sqfop_nular_end(); pair++)
+        for (const sqf::runtime::sqfop_nular& op : runtime.sqfop_nular_all())
         {
-            if (pair->first.name.length() < 2 || pair->first.name[pair->first.name.length() - 1] != '_' || pair->first.name[pair->first.name.length() - 2] != '_')
+            auto key = op.get_key();
+            if (key.name.length() < 2 || key.name[key.name.length() - 1] != '_' || key.name[key.name.length() - 2] != '_')
                 continue;
             outarr.push_back(std::vector<value> {
                 str,
-                    pair->first.name
+                    key.name
             });
         }
         str = "u";
-        for (auto pair = runtime.sqfop_unary_begin(); pair != runtime.sqfop_unary_end(); pair++)
+        for (const sqf::runtime::sqfop_unary& op : runtime.sqfop_unary_all())
         {
-            if (pair->first.name.length() < 2 || pair->first.name[pair->first.name.length() - 1] != '_' || pair->first.name[pair->first.name.length() - 2] != '_')
+            auto key = op.get_key();
+            if (key.name.length() < 2 || key.name[key.name.length() - 1] != '_' || key.name[key.name.length() - 2] != '_')
                 continue;
             outarr.push_back(std::vector<value> {
                 str,
-                    pair->first.name,
-                    pair->first.right_type.to_string()
+                    key.name,
+                    key.right_type.to_string()
             });
         }
         str = "b";
-        for (auto pair = runtime.sqfop_binary_begin(); pair != runtime.sqfop_binary_end(); pair++)
+        for (const sqf::runtime::sqfop_binary& op : runtime.sqfop_binary_all())
         {
-            if (pair->first.name.length() < 2 || pair->first.name[pair->first.name.length() - 1] != '_' || pair->first.name[pair->first.name.length() - 2] != '_')
+            auto key = op.get_key();
+            if (key.name.length() < 2 || key.name[key.name.length() - 1] != '_' || key.name[key.name.length() - 2] != '_')
                 continue;
             outarr.push_back(std::vector<value> {
                 str,
-                    pair->first.left_type.to_string(),
-                    pair->first.name,
-                    pair->first.right_type.to_string()
+                    key.left_type.to_string(),
+                    key.name,
+                    key.right_type.to_string()
             });
         }
         return outarr;
@@ -297,51 +374,54 @@ namespace
         std::stringstream sstream;
         std::string str = *right.data<d_string>();
         bool wasfound = false;
-        for (auto pair = runtime.sqfop_nular_begin(); pair != runtime.sqfop_nular_end(); pair++)
+        for (const sqf::runtime::sqfop_nular& op : runtime.sqfop_nular_all())
         {
-            if (pair->first.name != str)
+            auto key = op.get_key();
+            if (key.name != str)
                 continue;
-            auto cmd = pair->second;
+            auto cmd = op;
             if (cmd.description().empty())
             {
-                sstream << "NULAR '" << pair->first.name << "'\t<" << pair->first.name << ">" << std::endl;
+                sstream << "NULAR '" << key.name << "'\t<" << key.name << ">" << std::endl;
             }
             else
             {
-                sstream << "NULAR '" << pair->first.name << "'\t<" << cmd.name() << ">\t" << cmd.description() << std::endl;
+                sstream << "NULAR '" << key.name << "'\t<" << cmd.name() << ">\t" << cmd.description() << std::endl;
             }
             wasfound = true;
         }
-        for (auto pair = runtime.sqfop_unary_begin(); pair != runtime.sqfop_unary_end(); pair++)
+        for (const sqf::runtime::sqfop_unary& op : runtime.sqfop_unary_all())
         {
-            if (pair->first.name != str)
+            auto key = op.get_key();
+            if (key.name != str)
                 continue;
-            auto cmd = pair->second;
+            auto cmd = op;
             if (cmd.description().empty())
             {
-                sstream << "UNARY '" << pair->first.name << "'\t<" << cmd.name() << " " << pair->first.right_type.to_string() << ">" << std::endl;
+                sstream << "UNARY '" << key.name << "'\t<" << cmd.name() << " " << key.right_type.to_string() << ">" << std::endl;
             }
             else
             {
-                sstream << "UNARY '" << pair->first.name << "'\t<" << cmd.name() << " " << pair->first.right_type.to_string() << ">\t" << cmd.description() << std::endl;
+                sstream << "UNARY '" << key.name << "'\t<" << cmd.name() << " " << key.right_type.to_string() << ">\t" << cmd.description() << std::endl;
             }
             wasfound = true;
         }
-        for (auto pair = runtime.sqfop_binary_begin(); pair != runtime.sqfop_binary_end(); pair++)
+        for (const sqf::runtime::sqfop_binary& op : runtime.sqfop_binary_all())
         {
-            if (pair->first.name != str)
+            auto key = op.get_key();
+            if (key.name != str)
                 continue;
-            auto cmd = pair->second;
+            auto cmd = op;
             if (cmd.description().empty())
             {
-                sstream << "BINARY '" << pair->first.name << "'\t<" <<
-                    pair->first.left_type.to_string() << " " << cmd.name() << " " << pair->first.right_type.to_string() << ">" <<
+                sstream << "BINARY '" << key.name << "'\t<" <<
+                    key.left_type.to_string() << " " << cmd.name() << " " << key.right_type.to_string() << ">" <<
                     std::endl;
             }
             else
             {
-                sstream << "BINARY '" << pair->first.name << "'\t<" <<
-                    pair->first.left_type.to_string() << " " << cmd.name() << " " << pair->first.right_type.to_string() << ">\t" <<
+                sstream << "BINARY '" << key.name << "'\t<" <<
+                    key.left_type.to_string() << " " << cmd.name() << " " << key.right_type.to_string() << ">\t" <<
                     cmd.description() << std::endl;
             }
             wasfound = true;
@@ -361,13 +441,28 @@ namespace
     }
     value allObjects__(runtime& runtime)
     {
-        auto arr = std::make_shared<d_array>();
+        auto arr = sqf::runtime::make_pooled<d_array>();
         for (auto& object : runtime.storage<object, object::object_storage>())
         {
             arr->push_back(std::make_shared<d_object>(object));
         }
         return value(arr);
     }
+    value compilecache___(runtime& runtime)
+    {
+        auto& cache = runtime.compile_cache();
+        return std::vector<value> {
+            (sqf::runtime::scalar_t)cache.hits(),
+            (sqf::runtime::scalar_t)cache.misses(),
+            (sqf::runtime::scalar_t)cache.size(),
+            (sqf::runtime::scalar_t)cache.bytes(),
+            (sqf::runtime::scalar_t)cache.evictions()
+        };
+    }
+    value scalarsize___(runtime& runtime)
+    {
+        return (sqf::runtime::scalar_t)sizeof(sqf::runtime::scalar_t);
+    }
     value exit___(runtime& runtime)
     {
         runtime.exit(0);
@@ -375,7 +470,7 @@ namespace
     }
     value exit___scalar(runtime& runtime, value::cref right)
     {
-        runtime.exit(static_cast<int>(std::round(*right.data<d_scalar>())));
+        runtime.exit(static_cast<int>(std::round(right.data<d_scalar, sqf::runtime::scalar_t>())));
         return {};
     }
     value respawn___(runtime& runtime)
@@ -445,7 +540,7 @@ namespace
             left.data<d_code, sqf::runtime::instruction_set>(),
             {},
             std::make_shared<behavior_except>(right.data<d_code, sqf::runtime::instruction_set>()));
-        runtime.context_active().push_frame(f);
+        runtime.context_active().push_frame(std::move(f));
         return {};
     }
     value callstack___(runtime& runtime)
@@ -508,14 +603,14 @@ namespace
     }
     value pwd___(runtime& runtime)
     {
-        auto path = std::filesystem::path(runtime.context_active().current_frame().diag_info_from_position().path.physical);
+        auto path = std::filesystem::path(runtime.context_active().current_frame().diag_info_from_position().path().physical);
         auto str = std::filesystem::absolute(path).string();
         std::replace(str.begin(), str.end(), '\\', '/');
         return str;
     }
     value currentdirectory___(runtime& runtime)
     {
-        auto pathinfo = runtime.context_active().current_frame().diag_info_from_position().path;
+        auto pathinfo = runtime.context_active().current_frame().diag_info_from_position().path();
         auto path = std::filesystem::path(pathinfo.physical);
         auto str = std::filesystem::absolute(path.parent_path()).string();
         std::replace(str.begin(), str.end(), '\\', '/');
@@ -612,7 +707,7 @@ namespace
         frame f = { runtime.default_value_scope(), right.data<d_code, instruction_set>() };
         f["_this"] = left;
         f.bubble_variable(false);
-        runtime.context_active().push_frame(f);
+        runtime.context_active().push_frame(std::move(f));
         return {};
     }
     value nobubble___code(runtime& runtime, value::cref right)
@@ -620,7 +715,7 @@ namespace
         frame f = { runtime.default_value_scope(), right.data<d_code, instruction_set>() };
         f["_this"] = {};
         f.bubble_variable(false);
-        runtime.context_active().push_frame(f);
+        runtime.context_active().push_frame(std::move(f));
         return {};
     }
     value measureperformance___CODE(runtime& runtime, value::cref right)
@@ -679,7 +774,7 @@ namespace
         frame f = { runtime.default_value_scope(), {}, std::make_shared<behavior_measureoverhead>(right.data<d_code, sqf::runtime::instruction_set>(), 10000) };
         f["_this"] = {};
         f.bubble_variable(false);
-        runtime.context_active().push_frame(f);
+        runtime.context_active().push_frame(std::move(f));
         return {};
     }
     //value provide___code_string(runtime& runtime, value::cref left, value::cref right)
@@ -779,6 +874,8 @@ void sqf::operators::ops_sqfvm(sqf::runtime::runtime& runtime)
     // runtime.register_sqfop(unary("pretty__", t_code(), "Takes provided SQF code and pretty-prints it to output.", pretty___code));
     // runtime.register_sqfop(unary("prettysqf__", t_code(), "Takes provided SQF code and pretty-prints it to output.", pretty___code));
     // runtime.register_sqfop(unary("prettysqf__", t_string(), "Takes provided SQF code and pretty-prints it to output.", prettysqf___string));
+    runtime.register_sqfop(nular("compileCache__", "Returns the statistics of the compile cache in the format [hits, misses, entries, bytes, evictions].", compilecache___));
+    runtime.register_sqfop(nular("scalarSize__", "Returns the size in bytes of the floating point type backing SCALAR values, 4 for float and 8 for double.", scalarsize___));
     runtime.register_sqfop(nular("exit__", "Exits the VM execution immediately. Will not notify debug interface when used.", exit___));
     runtime.register_sqfop(unary("vmctrl__", t_string(), "Executes the provided SQF-VM exection action.", vmctrl___string));
     runtime.register_sqfop(unary("exitcode__", t_scalar(), "Exits the VM execution immediately. Will not notify debug interface when used. Allows to pass an exit code to the VM.", exit___scalar));
@@ -786,8 +883,14 @@ void sqf::operators::ops_sqfvm(sqf::runtime::runtime& runtime)
     runtime.register_sqfop(nular("respawn__", "'Respawns' the player object.", respawn___));
     runtime.register_sqfop(unary("preprocess__", t_string(), "Runs the PreProcessor on provided string.", preprocess___string));
     runtime.register_sqfop(unary("fromAssembly__", t_array(), "Parses the provided array of assembly instruction strings into actual code.", fromAssembly___array));
+    runtime.register_sqfop(unary("checkSqf__", t_string(), "Checks the syntax of the provided SQF text. Returns an array containing the messages the SQF parser reported.", checksqf___string));
+    runtime.register_sqfop(unary("checkAssembly__", t_string(), "Checks the syntax of the provided assembly text. Returns an array containing the messages the assembly parser reported.", checkassembly___string));
+    runtime.register_sqfop(unary("checkConfig__", t_string(), "Checks the syntax of the provided config text. Returns an array containing the messages the config parser reported.", checkconfig___string));
     runtime.register_sqfop(unary("assembly__", t_code(), "returns an array, containing the assembly instructions as string.", assembly___code));
+    runtime.register_sqfop(unary("optimize__", t_code(), "Runs the optimizer over the provided code, regardless of it being enabled. Nested code is left untouched.", optimize___code));
     runtime.register_sqfop(unary("assembly__", t_string(), "returns an array, containing the assembly instructions as string.", assembly___string));
+    runtime.register_sqfop(unary("serialize__", t_code(), "Serializes the provided code into the binary format used by the precompiled cache. Returns nil if the code cannot be serialized.", serialize___code));
+    runtime.register_sqfop(unary("deserialize__", t_string(), "Restores code from the binary format created by serialize__. Returns nil if the string is malformed.", deserialize___string));
     runtime.register_sqfop(binary(4, "except__", t_code(), t_code(), "Allows to define a block that catches VM exceptions. It is to note, that this will also catch exceptions in spawn! Exception will be put into the magic variable '_exception'. A callstack is available in '_callstack'.", except___code_code));
     runtime.register_sqfop(nular("callstack__", "Returns an array containing the whole callstack.", callstack___));
     runtime.register_sqfop(unary("allFiles__", t_array(),
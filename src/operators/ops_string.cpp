@@ -51,7 +51,7 @@ namespace
             runtime.__logmsg(err::ExpectedArrayTypeMissmatch(runtime.context_active().current_frame().diag_info_from_position(), 0, t_scalar(), arr->at(0).type()));
             return {};
         }
-        int start = static_cast<int>(std::round(arr->at(0).data<d_scalar, float>()));
+        int start = static_cast<int>(std::round(arr->at(0).data<d_scalar, sqf::runtime::scalar_t>()));
         if (start < 0)
         {
             runtime.__logmsg(err::NegativeIndexWeak(runtime.context_active().current_frame().diag_info_from_position()));
@@ -71,7 +71,7 @@ namespace
                 runtime.__logmsg(err::ExpectedArrayTypeMissmatch(runtime.context_active().current_frame().diag_info_from_position(), 1, t_scalar(), arr->at(1).type()));
                 return {};
             }
-            int length = static_cast<int>(std::round(arr->at(1).data<d_scalar, float>()));
+            int length = static_cast<int>(std::round(arr->at(1).data<d_scalar, sqf::runtime::scalar_t>()));
             if (length < 0)
             {
                 runtime.__logmsg(err::NegativeIndexWeak(runtime.context_active().current_frame().diag_info_from_position()));
@@ -258,7 +258,7 @@ namespace
     }
     value parsenumber_string(runtime& runtime, value::cref right)
     {
-        return value(strtof(right.data<d_string, std::string>().c_str(), nullptr));
+        return value(strtod(right.data<d_string, std::string>().c_str(), nullptr));
     }
     value endl_(runtime& runtime)
     {
@@ -10,12 +10,13 @@
 #include "../../runtime/d_code.h"
 #include <algorithm>
 #include <charconv>
+#include <limits>
 #include <sstream>
 
 using namespace std::string_literals;
 using namespace std::string_view_literals;
 
-sqf::runtime::value sqf::parser::assembly::parser::get_value(::sqf::runtime::runtime& runtime, std::string_view contents, const ::sqf::parser::assembly::bison::astnode& node)
+sqf::runtime::value sqf::parser::assembly::parser::get_value(::sqf::runtime::runtime& runtime, ::sqf::runtime::diagnostics::source_table& sources, const ::sqf::parser::assembly::bison::astnode& node)
 {
     switch (node.kind)
     {
@@ -30,7 +31,7 @@ sqf::runtime::value sqf::parser::assembly::parser::get_value(::sqf::runtime::run
             }
             catch (std::out_of_range&)
             {
-                return ::sqf::runtime::value(std::make_shared<::sqf::types::d_scalar>(std::nanf("")));
+                return ::sqf::runtime::value(std::make_shared<::sqf::types::d_scalar>(std::numeric_limits<::sqf::runtime::scalar_t>::quiet_NaN()));
             }
         }
         break;
@@ -42,7 +43,7 @@ sqf::runtime::value sqf::parser::assembly::parser::get_value(::sqf::runtime::run
             }
             catch (std::out_of_range&)
             {
-                return ::sqf::runtime::value(std::make_shared<::sqf::types::d_scalar>(std::nanf("")));
+                return ::sqf::runtime::value(std::make_shared<::sqf::types::d_scalar>(std::numeric_limits<::sqf::runtime::scalar_t>::quiet_NaN()));
             }
         }
         break;
@@ -68,7 +69,7 @@ sqf::runtime::value sqf::parser::assembly::parser::get_value(::sqf::runtime::run
             for (size_t i = 0; i < node.children.size(); i++)
             {
                 previous_node = node.children[i];
-                to_assembly(runtime, contents, previous_node, tmp_set);
+                to_assembly(runtime, sources, previous_node, tmp_set);
             }
             auto inst_set = ::sqf::runtime::instruction_set(tmp_set);
             return ::sqf::runtime::value(std::make_shared<::sqf::types::d_code>(inst_set));
@@ -79,31 +80,31 @@ sqf::runtime::value sqf::parser::assembly::parser::get_value(::sqf::runtime::run
             std::vector<::sqf::runtime::value> values;
             for (auto& subnode : node.children)
             {
-                values.push_back(get_value(runtime, contents, subnode));
+                values.push_back(get_value(runtime, sources, subnode));
             }
             return ::sqf::runtime::value(std::make_shared<::sqf::types::d_array>(values));
         }
         break;
     }
 }
-void ::sqf::parser::assembly::parser::to_assembly(::sqf::runtime::runtime& runtime, std::string_view contents, const ::sqf::parser::assembly::bison::astnode& node, std::vector<::sqf::runtime::instruction::sptr>& set)
+void ::sqf::parser::assembly::parser::to_assembly(::sqf::runtime::runtime& runtime, ::sqf::runtime::diagnostics::source_table& sources, const ::sqf::parser::assembly::bison::astnode& node, std::vector<::sqf::runtime::instruction::sptr>& set)
 {
 
     switch (node.kind)
     {
         case bison::astkind::ASSIGN_TO: {
             auto inst = std::make_shared<::sqf::opcodes::assign_to>(::sqf::types::d_string::from_sqf(node.children[1].token.contents));
-            inst->diag_info({ node.token.line, node.token.column, node.token.offset, { *node.token.path, {} }, create_code_segment(contents, node.token.offset, node.token.contents.length()) });
+            inst->diag_info(sources.create(node.token.line, node.token.column, node.token.offset, node.token.contents.length(), *node.token.path));
             set.push_back(inst);
         } break;
         case bison::astkind::ASSIGN_TO_LOCAL: {
             auto inst = std::make_shared<::sqf::opcodes::assign_to_local>(::sqf::types::d_string::from_sqf(node.children[1].token.contents));
-            inst->diag_info({ node.token.line, node.token.column, node.token.offset, { *node.token.path, {} }, create_code_segment(contents, node.token.offset, node.token.contents.length()) });
+            inst->diag_info(sources.create(node.token.line, node.token.column, node.token.offset, node.token.contents.length(), *node.token.path));
             set.push_back(inst);
         } break;
         case bison::astkind::GET_VARIABLE: {
             auto inst = std::make_shared<::sqf::opcodes::get_variable>(::sqf::types::d_string::from_sqf(node.children[1].token.contents));
-            inst->diag_info({ node.token.line, node.token.column, node.token.offset, { *node.token.path, {} }, create_code_segment(contents, node.token.offset, node.token.contents.length()) });
+            inst->diag_info(sources.create(node.token.line, node.token.column, node.token.offset, node.token.contents.length(), *node.token.path));
             set.push_back(inst);
         } break;
         case bison::astkind::CALL_BINARY: {
@@ -120,23 +121,23 @@ void ::sqf::parser::assembly::parser::to_assembly(::sqf::runtime::runtime& runti
                 auto prec = binary_ops.begin()->get().precedence();
 
                 auto inst = std::make_shared<::sqf::opcodes::call_binary>(str, prec);
-                inst->diag_info({ node.token.line, node.token.column, node.token.offset, { *node.token.path, {} }, create_code_segment(contents, node.token.offset, node.token.contents.length()) });
+                inst->diag_info(sources.create(node.token.line, node.token.column, node.token.offset, node.token.contents.length(), *node.token.path));
                 set.push_back(inst);
             }
         } break;
         case bison::astkind::CALL_UNARY: {
             auto inst = std::make_shared<::sqf::opcodes::call_unary>(std::string(node.children[1].token.contents));
-            inst->diag_info({ node.token.line, node.token.column, node.token.offset, { *node.token.path, {} }, create_code_segment(contents, node.token.offset, node.token.contents.length()) });
+            inst->diag_info(sources.create(node.token.line, node.token.column, node.token.offset, node.token.contents.length(), *node.token.path));
             set.push_back(inst);
         } break;
         case bison::astkind::CALL_NULAR: {
             auto inst = std::make_shared<::sqf::opcodes::call_nular>(std::string(node.children[1].token.contents));
-            inst->diag_info({ node.token.line, node.token.column, node.token.offset, { *node.token.path, {} }, create_code_segment(contents, node.token.offset, node.token.contents.length()) });
+            inst->diag_info(sources.create(node.token.line, node.token.column, node.token.offset, node.token.contents.length(), *node.token.path));
             set.push_back(inst);
         } break;
         case bison::astkind::END_STATEMENT: {
             auto inst = std::make_shared<::sqf::opcodes::end_statement>();
-            inst->diag_info({ node.token.line, node.token.column, node.token.offset, { *node.token.path, {} }, create_code_segment(contents, node.token.offset, node.token.contents.length()) });
+            inst->diag_info(sources.create(node.token.line, node.token.column, node.token.offset, node.token.contents.length(), *node.token.path));
             set.push_back(inst);
         } break;
         case bison::astkind::PUSH:
@@ -149,11 +150,11 @@ void ::sqf::parser::assembly::parser::to_assembly(::sqf::runtime::runtime& runti
                 if (i != 0)
                 {
                     auto inst = std::make_shared<::sqf::opcodes::end_statement>();
-                    inst->diag_info({ previous_node.token.line, previous_node.token.column + previous_node.token.contents.length(), previous_node.token.offset, { *previous_node.token.path, {} }, create_code_segment(contents, previous_node.token.offset, previous_node.token.contents.length()) });
+                    inst->diag_info(sources.create(previous_node.token.line, previous_node.token.column + previous_node.token.contents.length(), previous_node.token.offset, previous_node.token.contents.length(), *previous_node.token.path));
                     set.push_back(inst);
                 }
                 previous_node = node.children[i];
-                to_assembly(runtime, contents, previous_node, set);
+                to_assembly(runtime, sources, previous_node, set);
             }
         }
     }
@@ -178,7 +179,8 @@ std::optional<sqf::runtime::instruction_set> sqf::parser::assembly::parser::pars
         return {};
     }
     std::vector<::sqf::runtime::instruction::sptr> vec;
-    to_assembly(runtime, contents, res, vec);
+    ::sqf::runtime::diagnostics::source_table sources(contents);
+    to_assembly(runtime, sources, res, vec);
     return vec;
 }
 
@@ -23,8 +23,8 @@ namespace sqf::parser::assembly
     class parser : public ::sqf::runtime::parser::sqf, public CanLog
     {
     private:
-        ::sqf::runtime::value get_value(::sqf::runtime::runtime& runtime, std::string_view contents, const ::sqf::parser::assembly::bison::astnode& node);
-        void to_assembly(::sqf::runtime::runtime& runtime, std::string_view contents, const ::sqf::parser::assembly::bison::astnode& node, std::vector<::sqf::runtime::instruction::sptr>& set);
+        ::sqf::runtime::value get_value(::sqf::runtime::runtime& runtime, ::sqf::runtime::diagnostics::source_table& sources, const ::sqf::parser::assembly::bison::astnode& node);
+        void to_assembly(::sqf::runtime::runtime& runtime, ::sqf::runtime::diagnostics::source_table& sources, const ::sqf::parser::assembly::bison::astnode& node, std::vector<::sqf::runtime::instruction::sptr>& set);
     public:
         parser(Logger& logger) : CanLog(logger)
         {
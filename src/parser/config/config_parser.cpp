@@ -7,6 +7,7 @@
 #include "../../runtime/d_scalar.h"
 #include <algorithm>
 #include <charconv>
+#include <limits>
 #include <sstream>
 
 
@@ -89,7 +90,7 @@ bool sqf::parser::config::parser::apply_to_confighost(::sqf::parser::config::bis
                }
                catch (std::out_of_range&)
                {
-                   parent.value(sqf::runtime::value(std::make_shared<sqf::types::d_scalar>(std::nanf(""))));
+                   parent.value(sqf::runtime::value(std::make_shared<sqf::types::d_scalar>(std::numeric_limits<::sqf::runtime::scalar_t>::quiet_NaN())));
                }
            } break;
            case ::sqf::parser::config::bison::astkind::NUMBER_HEXADECIMAL: {
@@ -102,7 +103,7 @@ bool sqf::parser::config::parser::apply_to_confighost(::sqf::parser::config::bis
                }
                catch (std::out_of_range&)
                {
-                   parent.value(sqf::runtime::value(std::make_shared<sqf::types::d_scalar>(std::nanf(""))));
+                   parent.value(sqf::runtime::value(std::make_shared<sqf::types::d_scalar>(std::numeric_limits<::sqf::runtime::scalar_t>::quiet_NaN())));
                }
            } break;
            case ::sqf::parser::config::bison::astkind::STRING: {
@@ -163,16 +164,32 @@ bool sqf::parser::config::parser::check_syntax(std::string contents, ::sqf::runt
 
 bool sqf::parser::config::parser::parse(::sqf::runtime::confighost& target, std::string contents, ::sqf::runtime::fileio::pathinfo pathinfo)
 {
-    tokenizer t(contents.begin(), contents.end(), pathinfo.physical);
-    ::sqf::parser::config::bison::astnode res;
-    ::sqf::parser::config::bison::parser p(t, res, *this);
+    auto t = parse_tree(std::move(contents), std::move(pathinfo));
+    if (!t.has_value())
+    {
+        return {};
+    }
+    return apply(target, *t);
+}
+
+std::optional<sqf::parser::config::parser::tree> sqf::parser::config::parser::parse_tree(std::string contents, ::sqf::runtime::fileio::pathinfo pathinfo)
+{
+    tree t;
+    t.m_contents = std::make_unique<std::string>(std::move(contents));
+    t.m_tokenizer = std::make_unique<tokenizer>(t.m_contents->begin(), t.m_contents->end(), pathinfo.physical);
+    t.m_root = std::make_shared<::sqf::parser::config::bison::astnode>();
+    ::sqf::parser::config::bison::parser p(*t.m_tokenizer, *t.m_root, *this);
     // p.set_debug_level(1);
     bool success = p.parse() == 0;
     if (!success)
     {
         return {};
     }
-    std::vector<::sqf::runtime::instruction::sptr> vec;
+    return t;
+}
+
+bool sqf::parser::config::parser::apply(::sqf::runtime::confighost& target, const tree& t)
+{
     auto root = target.root();
-    return apply_to_confighost(res, target, root);
+    return apply_to_confighost(*t.m_root, target, root);
 }
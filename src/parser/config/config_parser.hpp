@@ -10,6 +10,8 @@
 #include <string>
 #include <string_view>
 #include <vector>
+#include <memory>
+#include <optional>
 #include <runtime/confighost.h>
 
 
@@ -22,6 +24,18 @@ namespace sqf::parser::config
 {
     class parser : public ::sqf::runtime::parser::config, public CanLog
     {
+    public:
+        /// <summary>
+        /// A config that got parsed but not yet applied to any confighost.
+        /// Owns the contents and tokenizer the tree points into, hence can be moved freely.
+        /// </summary>
+        class tree
+        {
+            friend class parser;
+            std::unique_ptr<std::string> m_contents;
+            std::unique_ptr<tokenizer> m_tokenizer;
+            std::shared_ptr<::sqf::parser::config::bison::astnode> m_root;
+        };
     private:
         bool apply_to_confighost(::sqf::parser::config::bison::astnode& node, ::sqf::runtime::confighost& confighost, ::sqf::runtime::confignav parent);
     public:
@@ -36,5 +50,16 @@ namespace sqf::parser::config
         virtual ~parser() override { };
         virtual bool check_syntax(std::string contents, ::sqf::runtime::fileio::pathinfo pathinfo) override;
         virtual bool parse(::sqf::runtime::confighost& target, std::string contents, ::sqf::runtime::fileio::pathinfo pathinfo) override;
+
+        /// <summary>
+        /// Parses the given contents without applying them anywhere.
+        /// Does not touch any confighost, hence may be called concurrently.
+        /// </summary>
+        /// <returns>The tree or an empty optional if the contents could not be parsed.</returns>
+        std::optional<tree> parse_tree(std::string contents, ::sqf::runtime::fileio::pathinfo pathinfo);
+        /// <summary>
+        /// Applies a tree created by parse_tree to the provided confighost.
+        /// </summary>
+        bool apply(::sqf::runtime::confighost& target, const tree& t);
     };
 }
@@ -1,9 +1,8 @@
 #pragma once
-#include "../../runtime/util.h"
+#include "../scanner.hpp"
 #include <array>
 #include <string>
 #include <string_view>
-#include <cctype>
 #include <vector>
 namespace sqf::parser::config
 {
@@ -56,66 +55,16 @@ namespace sqf::parser::config
         using iterator = std::string::iterator;
     private:
         std::vector<std::string*> m_strings;
-        iterator m_start;
-        iterator m_current;
-        iterator m_end;
+        const char* m_start;
+        const char* m_current;
+        const char* m_end;
         emode m_mode;
 
         size_t m_line;
         size_t m_column;
 
-        template<typename = void>
-        inline bool is_match(char value) { return false; }
-        template<char TArg, char ... TArgs>
-        bool is_match(char value)
-        {
-            switch (value)
-            {
-            case TArg: return true;
-            default: return is_match<TArgs...>(value);
-            }
-        }
-        template<char ... TArgs>
-        bool is_match(iterator value) { return value < m_end && is_match<TArgs...>(*value); }
-        template<size_t len, char ... TArgs>
-        bool is_match_repeated(iterator value)
-        {
-            size_t i = 0;
-            while (value < m_end && is_match<TArgs...>(*value++)) { ++i; }
-            return len <= i;
-        }
-
-        template<char ... TArgs>
-        size_t len_match(iterator str)
-        {
-            iterator it = str;
-            while (it < m_end && is_match<TArgs...>(*it)) { ++it; }
-            return it - str;
-        }
-        size_t len_match(iterator start, const char* against)
-        {
-            auto it = start;
-            auto len = ::sqf::runtime::util::strlen(against);
-            for (size_t i = 0; i < len && it < m_end; i++, ++it)
-            {
-                if ((char)std::tolower(*it) != against[i]) { return 0; }
-            }
-            return it - start;
-        }
-        size_t len_ident_match(iterator start, const char* against)
-        {
-            auto it = start;
-            auto len = ::sqf::runtime::util::strlen(against);
-            for (size_t i = 0; i < len && it < m_end; i++, ++it)
-            {
-                if ((char)std::tolower(*it) != against[i]) { return 0; }
-            }
-            if (it < m_end && ((char)std::tolower(*it) >= 'a' && (char)std::tolower(*it) <= 'z'))
-            {
-                return 0;
-            }
-            return it - start;
-        }
+        bool is_match(const char* it, char c) const { return it < m_end && *it == c; }
+        bool is_match(const char* it, char a, char b) const { return it < m_end && (*it == a || *it == b); }
 
         token try_match(std::initializer_list<etoken> tokens)
         {
@@ -130,20 +79,20 @@ namespace sqf::parser::config
 
                 case etoken::m_line: /* ToDo: Properly handle #line instruction */ {
                     // Check if line comment start
-                    if (len_ident_match(iter, "#line"))
+                    if (scanner::keyword(iter, m_end, "#line") != iter)
                     {
-                        iter += 6;
+                        iter = m_end - iter > 6 ? iter + 6 : m_end;
 
                         // Read in line num
                         auto start = iter;
-                        for (; iter != m_end && *iter != '\n' && *iter != ' '; iter++);
+                        for (; iter < m_end && *iter != '\n' && *iter != ' '; iter++);
                         std::string str_tmp(start, iter);
                         m_line = static_cast<size_t>(std::stoul(str_tmp));
 
                         // Try skip to file
-                        iter += len_match<' ', '\t'>(iter);
+                        for (; iter < m_end && (*iter == ' ' || *iter == '\t'); iter++);
                         start = iter;
-                        for (; iter != m_end && *iter != '\n'; iter++);
+                        iter = scanner::find(iter, m_end, '\n');
                         if (iter != m_end && iter - start >= 2)
                         {
                             // Read-in file
@@ -157,219 +106,54 @@ namespace sqf::parser::config
                         len = iter - m_current;
                     }
                 } break;
-                case etoken::i_comment_line: {
-                    // Check if line comment start
-                    if (is_match_repeated<2, '/'>(iter))
-                    {
-                        // find line comment end
-                        while (!is_match<'\n'>(++iter));
-
-                        // update position info
-                        m_line++;
-                        m_column = 0;
+                case etoken::i_comment_line:     len = scanner::skip_comment_line(iter, m_end, m_line, m_column) - m_current; break;
+                case etoken::i_comment_block:    len = scanner::skip_comment_block(iter, m_end, m_line, m_column) - m_current; break;
+                case etoken::i_whitespace:       len = scanner::skip_whitespace(iter, m_end, m_line, m_column) - m_current; break;
 
-                        // set length
-                        len = iter - m_current;
-                    }
-                } break;
-                case etoken::i_comment_block: {
-                    // Check if block comment start
-                    if (is_match<'/'>(iter) && is_match<'*'>(iter + 1))
-                    {
-                        ++iter;
-                        ++iter;
-                        // find block comment end
-                        while (!(is_match<'*'>(iter) && is_match<'/'>(iter + 1)))
-                        {
-                            // update position info
-                            if (!is_match<'\n'>(iter))
-                            {
-                                m_column++;
-                            }
-                            else
-                            {
-                                m_line++;
-                                m_column = 0;
-                            }
-                            ++iter;
-                        }
+                case etoken::t_class:            len = scanner::keyword(iter, m_end, "class") - iter; break;
+                case etoken::t_delete:           len = scanner::keyword(iter, m_end, "delete") - iter; break;
 
-                        // EOF check
-                        if (is_match<'/'>(iter) && is_match<'/'>(iter + 1))
-                        {
-                            ++iter;
-                            ++iter;
-                        }
-                        // set length
-                        len = iter - m_current;
-                    }
-                } break;
-                case etoken::i_whitespace: {
-                    while (is_match<' ', '\n', '\r', '\t'>(iter))
-                    {
-                        // update position info
-                        if (!is_match<'\n'>(iter))
-                        {
-                            m_column++;
-                        }
-                        else
-                        {
-                            m_line++;
-                            m_column = 0;
-                        }
-                        ++iter;
-                    }
-                    // set length
-                    len = iter - m_current;
-                } break;
-
-                case etoken::t_class:            len = len_ident_match(iter, "class"); break;
-                case etoken::t_delete:           len = len_ident_match(iter, "delete"); break;
-
-                case etoken::s_curlyo:           len = is_match<'{'>(iter); break;
-                case etoken::s_curlyc:           len = is_match<'}'>(iter); break;
-                case etoken::s_edgeo:            len = is_match<'['>(iter); break;
-                case etoken::s_edgec:            len = is_match<']'>(iter); break;
-                case etoken::s_equal:            len = is_match<'='>(iter); break;
-                case etoken::s_colon:            len = is_match<':'>(iter); break;
-                case etoken::s_semicolon:        len = is_match<';'>(iter); break;
-                case etoken::s_comma:            len = is_match<','>(iter); break;
-                case etoken::t_plus_equal:       len = len_ident_match(iter, "+="); break;
+                case etoken::s_curlyo:           len = is_match(iter, '{'); break;
+                case etoken::s_curlyc:           len = is_match(iter, '}'); break;
+                case etoken::s_edgeo:            len = is_match(iter, '['); break;
+                case etoken::s_edgec:            len = is_match(iter, ']'); break;
+                case etoken::s_equal:            len = is_match(iter, '='); break;
+                case etoken::s_colon:            len = is_match(iter, ':'); break;
+                case etoken::s_semicolon:        len = is_match(iter, ';'); break;
+                case etoken::s_comma:            len = is_match(iter, ','); break;
+                case etoken::t_plus_equal:       len = scanner::keyword(iter, m_end, "+=") - iter; break;
                 case etoken::any:                len = 1; break;
 
-                case etoken::t_string_single: {
-                    ++iter;
-                    m_column++;
-                    // find string end
-                    while (true)
-                    {
-                        if (is_match<'\''>(iter) && is_match<'\''>(iter + 1))
-                        {
-                            ++iter;
-                        }
-                        else if (is_match<'\''>(iter))
-                        {
-                            ++iter;
-                            m_column++;
-                            break;
-                        }
-                        // update position info
-                        if (!is_match<'\n'>(iter))
-                        {
-                            m_column++;
-                        }
-                        else
-                        {
-                            m_line++;
-                            m_column = 0;
-                        }
-                        ++iter;
-                    }
-                    // set length
-                    len = iter - m_current;
-                } break;
-                case etoken::t_string_double: {
-                    ++iter;
-                    m_column++;
-                    // find string end
-                    while (true)
-                    {
-                        if (is_match<'"'>(iter) && is_match<'"'>(iter + 1))
-                        {
-                            ++iter;
-                        }
-                        else if (is_match<'"'>(iter))
-                        {
-                            ++iter;
-                            m_column++;
-                            break;
-                        }
-                        // update position info
-                        if (!is_match<'\n'>(iter))
-                        {
-                            m_column++;
-                        }
-                        else
-                        {
-                            m_line++;
-                            m_column = 0;
-                        }
-                        if (iter == m_end)
-                        {
-                            break;
-                        }
-                        else
-                        {
-                            iter++;
-                        }
-                    }
-                    // set length
-                    len = iter - m_current;
-                } break;
-                case etoken::t_ident: {
-                    len = len_match<
-                        'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
-                        'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
-                        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '_'>(iter);
-                } break;
-                case etoken::t_hexadecimal: {
-                    if (*iter == '$')
-                    {
-                        ++iter;
-
-                        size_t res = len_match<'0', '1', '2', '3', '4', '5', '6', '7', '8', '9',
-                            'A', 'B', 'C', 'D', 'E', 'F',
-                            'a', 'b', 'c', 'd', 'e', 'f'>(iter);
-                        if (res == 0) { len = 0; break; }
-                        len = (iter + res) - m_current;
-                    }
-                    else
-                    {
-                        ++iter;
-                        size_t res = 0;
-                        res = is_match<'x'>(iter);
-                        if (res == 0) { len = 0; break; }
-                        ++iter;
-
-                        res = len_match<'0', '1', '2', '3', '4', '5', '6', '7', '8', '9',
-                            'A', 'B', 'C', 'D', 'E', 'F',
-                            'a', 'b', 'c', 'd', 'e', 'f'>(iter);
-                        if (res == 0) { len = 0; break; }
-                        len = (iter + res) - m_current;
-                    }
-                } break;
+                case etoken::t_string_single:    len = scanner::skip_string(iter, m_end, '\'', m_line, m_column) - m_current; break;
+                case etoken::t_string_double:    len = scanner::skip_string(iter, m_end, '"', m_line, m_column) - m_current; break;
+                case etoken::t_ident:            len = scanner::span_ident(iter, m_end) - iter; break;
+                case etoken::t_hexadecimal:      len = scanner::skip_hexadecimal(iter, m_end) - iter; break;
                 case etoken::t_number: {
-                    bool is_good = false;
-                    if (is_match<'+', '-'>(iter)) { ++iter; }
-                    if (!is_match<'.'>(iter))
+                    if (is_match(iter, '+', '-')) { ++iter; }
+                    if (!is_match(iter, '.'))
                     {
-                        is_good = true;
                         // match first part of number
-                        auto res = len_match<'0', '1', '2', '3', '4', '5', '6', '7', '8', '9'>(iter);
-                        if (res == 0) { len = 0; break; }
-                        else { iter += res; }
+                        auto res = scanner::span(iter, m_end, scanner::digit);
+                        if (res == iter) { len = 0; break; }
+                        else { iter = res; }
                     }
-                    if (is_match<'.'>(iter))
+                    if (is_match(iter, '.'))
                     {
-                        is_good = true;
-                        ++iter;
                         // match second part of number
-                        auto res = len_match<'0', '1', '2', '3', '4', '5', '6', '7', '8', '9'>(iter);
-                        if (res == 0) { --iter; }
-                        else { iter += res; }
+                        auto res = scanner::span(iter + 1, m_end, scanner::digit);
+                        if (res != iter + 1) { iter = res; }
                     }
-                    if (is_match<'e', 'E'>(iter))
+                    if (is_match(iter, 'e', 'E'))
                     {
-                        is_good = true;
-                        ++iter;
-                        if (is_match<'+', '-'>(iter)) { ++iter; }
+                        auto res = iter + 1;
+                        if (is_match(res, '+', '-')) { ++res; }
                         // match second part of number
-                        auto res = len_match<'0', '1', '2', '3', '4', '5', '6', '7', '8', '9'>(iter);
-                        if (res == 0) { --iter; }
-                        else { iter += res; }
+                        auto digits = scanner::span(res, m_end, scanner::digit);
+                        if (digits != res) { iter = digits; }
+                        else { iter = res - 1; }
                     }
-                    if (is_good && !is_match< 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
-                        'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', '_'>(iter))
+                    // Numbers directly followed by a letter (eg. 1st) are identifiers instead
+                    if (iter == m_end || !scanner::is(*iter, scanner::alpha | scanner::underscore))
                     {
                         len = iter - m_current;
                     }
@@ -379,7 +163,7 @@ namespace sqf::parser::config
                 if (len > 0)
                 {
                     t.type = token_type;
-                    t.contents = { &*m_current,  len }; // Dirty hack thanks to std::string_view not accepting iterators ...
+                    t.contents = { m_current, len };
                     m_current += len;
                     switch (token_type)
                     {
@@ -404,9 +188,9 @@ namespace sqf::parser::config
 
     public:
         tokenizer(iterator start, iterator end, std::string path) :
-            m_start(start),
-            m_current(start),
-            m_end(end),
+            m_start(start == end ? nullptr : &*start),
+            m_current(m_start),
+            m_end(m_start + (end - start)),
             m_mode(emode::normal),
             m_line(0),
             m_column(0)
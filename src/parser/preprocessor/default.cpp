@@ -12,6 +12,7 @@
 #include <string>
 #include <optional>
 #include <iostream>
+#include <mutex>
 
 #if defined(DF__SQF_PREPROC__TRACE_MACRO_RESOLVE) || defined(DF__SQF_PREPROC__TRACE_MACRO_PARSE)
 #include <iostream>
@@ -28,19 +29,19 @@ void sqf::parser::preprocessor::impl_default::instance::replace_stringify(
     preprocessorfileinfo& original_fileinfo,
     const ::sqf::runtime::parser::macro& m,
     std::vector<std::string>& params,
-    std::stringstream& sstream,
+    std::string& output,
     const std::unordered_map<std::string, std::string>& param_map)
 {
 #ifdef DF__SQF_PREPROC__TRACE_MACRO_RESOLVE
-    auto ___begin = sstream.tellp();
+    auto ___begin = output.size();
 #endif
     char c;
-    replace_skip(runtime, local_fileinfo, sstream);
+    replace_skip(runtime, local_fileinfo, output);
     c = local_fileinfo.peek();
     if (c == '#')
     {
         local_fileinfo.next();
-        replace_concat(runtime, local_fileinfo, original_fileinfo, m, params, sstream, param_map);
+        replace_concat(runtime, local_fileinfo, original_fileinfo, m, params, output, param_map);
     }
     else
     {
@@ -51,35 +52,27 @@ void sqf::parser::preprocessor::impl_default::instance::replace_stringify(
         {
             word[i] = local_fileinfo.next();
         }
-        auto param_res = std::find_if(
-            m.args().begin(),
-            m.args().end(),
-            [word](std::string s) -> bool {
-            return s.compare(word) == 0;
-        }
-        );
+        auto param_res = std::find(m.args().begin(), m.args().end(), word);
         if (param_res != m.args().end())
         {
             auto index = param_res - m.args().begin();
-            sstream << '"' << params[index] << '"';
+            output.push_back('"');
+            output.append(params[index]);
+            output.push_back('"');
         }
         else
         {
-            auto macro_res = std::find_if(
-                m_macros.begin(),
-                m_macros.end(),
-                [word](std::unordered_map<std::string, ::sqf::runtime::parser::macro>::value_type m) -> bool {
-                return m.first.compare(word) == 0;
-            }
-            );
+            auto macro_res = m_macros.find(word);
+            output.push_back('"');
             if (macro_res == m_macros.end())
             {
-                sstream << '"' << word << '"';
+                output.append(word);
             }
             else
             {
-                sstream << '"' << handle_macro(runtime, local_fileinfo, original_fileinfo, macro_res->second, param_map) << '"';
+                output.append(handle_macro(runtime, local_fileinfo, original_fileinfo, macro_res->second, param_map));
             }
+            output.push_back('"');
         }
     }
 #ifdef DF__SQF_PREPROC__TRACE_MACRO_RESOLVE
@@ -103,7 +96,7 @@ void sqf::parser::preprocessor::impl_default::instance::replace_stringify(
     }
     std::cout << " }";
 
-    std::cout << ", stringstream, unordered_map<string, string>: ";
+    std::cout << ", string, unordered_map<string, string>: ";
     std::cout << "{ ";
     ___first = false;
     for (auto& it : param_map)
@@ -119,7 +112,7 @@ void sqf::parser::preprocessor::impl_default::instance::replace_stringify(
         std::cout << "{ " << it.first << ", " << it.second << " }";
     }
     std::cout << " }";
-    std::cout << ")\033[0m:" << sstream.str().substr(___begin) << std::endl;
+    std::cout << ")\033[0m:" << output.substr(___begin) << std::endl;
 #endif
 }
 void sqf::parser::preprocessor::impl_default::instance::replace_concat(
@@ -128,14 +121,14 @@ void sqf::parser::preprocessor::impl_default::instance::replace_concat(
     preprocessorfileinfo& original_fileinfo,
     const ::sqf::runtime::parser::macro& m,
     std::vector<std::string>& params,
-    std::stringstream& sstream,
+    std::string& output,
     const std::unordered_map<std::string, std::string>& param_map)
 {
 #ifdef DF__SQF_PREPROC__TRACE_MACRO_RESOLVE
-    auto ___begin = sstream.tellp();
+    auto ___begin = output.size();
 #endif
     char c;
-    replace_skip(runtime, local_fileinfo, sstream);
+    replace_skip(runtime, local_fileinfo, output);
     c = local_fileinfo.peek();
     auto word_end = replace_find_wordend(runtime, local_fileinfo);
     std::string word;
@@ -144,34 +137,22 @@ void sqf::parser::preprocessor::impl_default::instance::replace_concat(
     {
         word[i] = local_fileinfo.next();
     }
-    auto param_res = std::find_if(
-        m.args().begin(),
-        m.args().end(),
-        [word](std::string s) -> bool {
-        return s.compare(word) == 0;
-    }
-    );
+    auto param_res = std::find(m.args().begin(), m.args().end(), word);
     if (param_res != m.args().end())
     {
         auto index = param_res - m.args().begin();
-        sstream << params[index];
+        output.append(params[index]);
     }
     else
     {
-        auto macro_res = std::find_if(
-            m_macros.begin(),
-            m_macros.end(),
-            [word](std::unordered_map<std::string, ::sqf::runtime::parser::macro>::value_type m) -> bool {
-            return m.first.compare(word) == 0;
-        }
-        );
+        auto macro_res = m_macros.find(word);
         if (macro_res == m_macros.end())
         {
-            sstream << word;
+            output.append(word);
         }
         else
         {
-            sstream << handle_macro(runtime, local_fileinfo, original_fileinfo, macro_res->second, param_map);
+            output.append(handle_macro(runtime, local_fileinfo, original_fileinfo, macro_res->second, param_map));
         }
     }
 #ifdef DF__SQF_PREPROC__TRACE_MACRO_RESOLVE
@@ -195,7 +176,7 @@ void sqf::parser::preprocessor::impl_default::instance::replace_concat(
     }
     std::cout << " }";
 
-    std::cout << ", stringstream, unordered_map<string, string>: ";
+    std::cout << ", string, unordered_map<string, string>: ";
     std::cout << "{ ";
     ___first = false;
     for (auto& it : param_map)
@@ -211,12 +192,13 @@ void sqf::parser::preprocessor::impl_default::instance::replace_concat(
         std::cout << "{ " << it.first << ", " << it.second << " }";
     }
     std::cout << " }";
-    std::cout << ")\033[0m:" << sstream.str().substr(___begin) << std::endl;
+    std::cout << ")\033[0m:" << output.substr(___begin) << std::endl;
 #endif
 }
 
-size_t sqf::parser::preprocessor::impl_default::instance::replace_find_wordend(::sqf::runtime::runtime& runtime, preprocessorfileinfo fileinfo)
+size_t sqf::parser::preprocessor::impl_default::instance::replace_find_wordend(::sqf::runtime::runtime& runtime, preprocessorfileinfo& fileinfo)
 {
+    auto state = fileinfo.save();
     auto currentOffset = fileinfo.off;
     size_t res;
     while (true)
@@ -247,6 +229,7 @@ size_t sqf::parser::preprocessor::impl_default::instance::replace_find_wordend(:
         }
     }
 exit:
+    fileinfo.restore(state);
 #ifdef DF__SQF_PREPROC__TRACE_MACRO_RESOLVE
     std::cout << "\x1B[33m[PREPROCESSOR-RS]\033[0m" <<
         "        " <<
@@ -255,12 +238,12 @@ exit:
 #endif
     return res;
 }
-void sqf::parser::preprocessor::impl_default::instance::replace_skip(::sqf::runtime::runtime& runtime, preprocessorfileinfo& fileinfo, std::stringstream& sstream)
+void sqf::parser::preprocessor::impl_default::instance::replace_skip(::sqf::runtime::runtime& runtime, preprocessorfileinfo& fileinfo, std::string& output)
 {
     bool flag = true;
     bool in_string = false;
 #ifdef DF__SQF_PREPROC__TRACE_MACRO_RESOLVE
-    auto ___begin = sstream.tellp();
+    auto ___begin = output.size();
 #endif
     while (flag)
     {
@@ -271,7 +254,7 @@ void sqf::parser::preprocessor::impl_default::instance::replace_skip(::sqf::runt
             {
                 in_string = false;
             }
-            sstream << c;
+            output.push_back(c);
         }
         else
         {
@@ -301,7 +284,7 @@ void sqf::parser::preprocessor::impl_default::instance::replace_skip(::sqf::runt
                 case '"':
                 in_string = true;
                 default:
-                sstream << fileinfo.next();
+                output.push_back(fileinfo.next());
             }
         }
     }
@@ -309,7 +292,7 @@ void sqf::parser::preprocessor::impl_default::instance::replace_skip(::sqf::runt
     std::cout << "\x1B[33m[PREPROCESSOR-RS]\033[0m" <<
         "        " <<
         "        " <<
-        "    " << "\x1B[36mreplace_skip(runtime, preprocessorfileinfo, stringstream)\033[0m: " << sstream.str().substr(___begin) << std::endl;
+        "    " << "\x1B[36mreplace_skip(runtime, preprocessorfileinfo, string)\033[0m: " << output.substr(___begin) << std::endl;
 #endif
 }
 std::string sqf::parser::preprocessor::impl_default::instance::replace(::sqf::runtime::runtime& runtime, preprocessorfileinfo& original_fileinfo, const ::sqf::runtime::parser::macro& m, std::vector<std::string>& params)
@@ -320,21 +303,40 @@ std::string sqf::parser::preprocessor::impl_default::instance::replace(::sqf::ru
         log(err::ArgCountMissmatch(m.diag_info()));
         return "";
     }
-    preprocessorfileinfo local_fileinfo(m.diag_info());
-    local_fileinfo.content = m.content();
-    local_fileinfo.line = m.diag_info().line;
     if (m.has_callback())
     {
+        m_volatile = true;
         return m(original_fileinfo, original_fileinfo, params, runtime);
     }
 
+    // Expansions only depend on the macro, its arguments and the other macros. Thus, unless volatile,
+    // the expansion gets reused until the next #define or #undef.
+    std::string key(m.name());
+    for (auto& param : params)
+    {
+        key.push_back('\0');
+        key.append(param);
+    }
+    auto memoised = m_expansions.find(key);
+    if (memoised != m_expansions.end())
+    {
+        return memoised->second;
+    }
+    auto outer_volatile = m_volatile;
+    m_volatile = false;
+
+    preprocessorfileinfo local_fileinfo(m.diag_info());
+    local_fileinfo.content = m.content();
+    local_fileinfo.line = m.diag_info().line;
+
     std::unordered_map<std::string, std::string> parammap;
     for (size_t i = 0; i < params.size(); i++)
     {
         parammap[m.args()[i]] = params[i];
     }
 
-    std::stringstream sstream;
+    std::string output;
+    output.reserve(m.content().size());
 
     char c;
     while (true)
@@ -345,13 +347,13 @@ std::string sqf::parser::preprocessor::impl_default::instance::replace(::sqf::ru
             "        " <<
             "    " << "\x1B[36mreplace(...)\033[0m: Remaining: " << local_fileinfo.content.substr(local_fileinfo.off) << std::endl;
 #endif
-        replace_skip(runtime, local_fileinfo, sstream);
+        replace_skip(runtime, local_fileinfo, output);
         c = local_fileinfo.peek();
 
         if (c == '#')
         {
             local_fileinfo.next();
-            replace_stringify(runtime, local_fileinfo, original_fileinfo, m, params, sstream, parammap);
+            replace_stringify(runtime, local_fileinfo, original_fileinfo, m, params, output, parammap);
         }
         else if (c == '\n' || c == '\0')
         {
@@ -370,7 +372,7 @@ std::string sqf::parser::preprocessor::impl_default::instance::replace(::sqf::ru
                     "        " <<
                     "    " << "\x1B[36mreplace(...)\033[0m: Appending end: " << local_fileinfo.next() << std::endl;
 #endif
-                sstream << local_fileinfo.next();
+                output.push_back(local_fileinfo.next());
             }
             else
             { // Receive next word
@@ -382,13 +384,7 @@ std::string sqf::parser::preprocessor::impl_default::instance::replace(::sqf::ru
                 }
 
                 // Check if word matches any parameter
-                auto param_res = std::find_if(
-                    m.args().begin(),
-                    m.args().end(),
-                    [word](std::string s) -> bool {
-                    return s.compare(word) == 0;
-                }
-                );
+                auto param_res = std::find(m.args().begin(), m.args().end(), word);
                 if (param_res != m.args().end())
                 { // word matches a parameter, replacee
                     auto index = param_res - m.args().begin();
@@ -398,20 +394,20 @@ std::string sqf::parser::preprocessor::impl_default::instance::replace(::sqf::ru
                         "        " <<
                         "    " << "\x1B[36mreplace(...)\033[0m: Inserting parameter[" << index << "]: " << params[index] << std::endl;
 #endif
-                    sstream << params[index];
+                    output.append(params[index]);
                 }
                 else
                 { // Check if word matches any macro
                     auto macro_res = m_macros.find(word);
                     if (macro_res == m_macros.end())
-                    { // word matches no macro, append to sstream
+                    { // word matches no macro, append to output
 #ifdef DF__SQF_PREPROC__TRACE_MACRO_RESOLVE
                         std::cout << "\x1B[33m[PREPROCESSOR-RS]\033[0m" <<
                             "        " <<
                             "        " <<
                             "    " << "\x1B[36mreplace(...)\033[0m: Adding word: " << word << std::endl;
 #endif
-                        sstream << word;
+                        output.append(word);
                     }
                     else
                     { // word matches macro, handle it
@@ -422,7 +418,7 @@ std::string sqf::parser::preprocessor::impl_default::instance::replace(::sqf::ru
                             "        " <<
                             "    " << "\x1B[36mreplace(...)\033[0m: Adding macro result: " << res << std::endl;
 #endif
-                        sstream << res;
+                        output.append(res);
                     }
                 }
             }
@@ -449,9 +445,14 @@ std::string sqf::parser::preprocessor::impl_default::instance::replace(::sqf::ru
         std::cout << it;
     }
     std::cout << " }";
-    std::cout << ")\033[0m: " << sstream.str() << std::endl;
+    std::cout << ")\033[0m: " << output << std::endl;
 #endif
-    return sstream.str();
+    if (!m_volatile && !m_errflag)
+    {
+        m_expansions.emplace(std::move(key), output);
+    }
+    m_volatile = m_volatile || outer_volatile;
+    return output;
 }
 std::string sqf::parser::preprocessor::impl_default::instance::handle_arg(::sqf::runtime::runtime& runtime, preprocessorfileinfo& local_fileinfo, preprocessorfileinfo& original_fileinfo, size_t endindex, const std::unordered_map<std::string, std::string>& param_map)
 {
@@ -459,7 +460,8 @@ std::string sqf::parser::preprocessor::impl_default::instance::handle_arg(::sqf:
     bool inside_word = false;
     bool string_mode = false;
     bool part_of_word = false;
-    std::stringstream sstream;
+    std::string output;
+    output.reserve(endindex > local_fileinfo.off ? endindex - local_fileinfo.off : 0);
     char c;
     while (local_fileinfo.off != endindex && (c = local_fileinfo.next()) != '\0')
     {
@@ -469,14 +471,14 @@ std::string sqf::parser::preprocessor::impl_default::instance::handle_arg(::sqf:
             {
                 string_mode = false;
             }
-            sstream << c;
+            output.push_back(c);
             continue;
         }
         switch (c)
         {
             case '"':
             string_mode = true;
-            sstream << c;
+            output.push_back(c);
             break;
             case 'a': case 'b': case 'c': case 'd': case 'e':
             case 'f': case 'g': case 'h': case 'i': case 'j':
@@ -505,28 +507,29 @@ std::string sqf::parser::preprocessor::impl_default::instance::handle_arg(::sqf:
             if (inside_word)
             {
                 inside_word = false;
-                auto word = local_fileinfo.content.substr(word_start, local_fileinfo.off - word_start - (!part_of_word ? 1 : 0));
+                std::string word(local_fileinfo.content.substr(word_start, local_fileinfo.off - word_start - (!part_of_word ? 1 : 0)));
                 auto res = try_get_macro(word);
-                if (res.has_value())
+                std::unordered_map<std::string, std::string>::const_iterator param_res;
+                if (res)
                 {
-                    if (res.value().is_callable())
+                    if (res->is_callable())
                     {
                         local_fileinfo.move_back();
                     }
-                    auto handled = handle_macro(runtime, local_fileinfo, original_fileinfo, res.value(), param_map);
+                    auto handled = handle_macro(runtime, local_fileinfo, original_fileinfo, *res, param_map);
                     if (m_errflag)
                     {
                         return "";
                     }
-                    sstream << handled;
-                    if (!res.value().is_callable() && !part_of_word)
+                    output.append(handled);
+                    if (!res->is_callable() && !part_of_word)
                     {
                         local_fileinfo.move_back();
                     }
                 }
-                else if (param_map.find(word) != param_map.end())
+                else if ((param_res = param_map.find(word)) != param_map.end())
                 {
-                    sstream << param_map.at(word);
+                    output.append(param_res->second);
                     if (!part_of_word)
                     {
                         local_fileinfo.move_back();
@@ -534,7 +537,7 @@ std::string sqf::parser::preprocessor::impl_default::instance::handle_arg(::sqf:
                 }
                 else
                 {
-                    sstream << word;
+                    output.append(word);
                     if (!part_of_word)
                     {
                         local_fileinfo.move_back();
@@ -543,13 +546,13 @@ std::string sqf::parser::preprocessor::impl_default::instance::handle_arg(::sqf:
             }
             else
             {
-                sstream << c;
+                output.push_back(c);
             }
             part_of_word = false;
             break;
         }
     }
-    return sstream.str();
+    return output;
 }
 std::string sqf::parser::preprocessor::impl_default::instance::handle_macro(::sqf::runtime::runtime& runtime, preprocessorfileinfo& local_fileinfo, preprocessorfileinfo& original_fileinfo, const ::sqf::runtime::parser::macro& m, const std::unordered_map<std::string, std::string>& param_map)
 { // Needs to handle 'NAME(ARG1, ARG2, ARGN)' not more, not less!
@@ -642,9 +645,10 @@ std::string sqf::parser::preprocessor::impl_default::instance::handle_macro(::sq
                     local_fileinfo.move_back();
                     if (local_fileinfo.off - lastargstart > 0)
                     {
-                        preprocessorfileinfo copy = local_fileinfo;
-                        copy.off = lastargstart;
-                        auto handled_param = handle_arg(runtime, copy, original_fileinfo, local_fileinfo.off, param_map);
+                        auto state = local_fileinfo.save();
+                        local_fileinfo.off = lastargstart;
+                        auto handled_param = handle_arg(runtime, local_fileinfo, original_fileinfo, state.off, param_map);
+                        local_fileinfo.restore(state);
                         params.emplace_back(std::move(handled_param));
 #ifdef DF__SQF_PREPROC__TRACE_MACRO_RESOLVE
                         std::cout << "\x1B[33m[PREPROCESSOR-RS]\033[0m" <<
@@ -663,6 +667,7 @@ std::string sqf::parser::preprocessor::impl_default::instance::handle_macro(::sq
 #endif
                         params.emplace_back("");
                         log(err::EmptyArgument(original_fileinfo.to_diag_info()));
+                        m_volatile = true; // Warning has to be reported again on every use
                     }
                     local_fileinfo.next();
                     lastargstart = local_fileinfo.off;
@@ -724,8 +729,14 @@ std::string sqf::parser::preprocessor::impl_default::instance::parse_ppinstructi
                 log(err::RecursiveInclude(fileinfo.to_diag_info(), includeTree.str()));
                 return "";
             }
+            auto include_file = m_owner->load_include_file(runtime, *include_path_info);
+            if (include_file->guard.has_value() && m_macros.find(*include_file->guard) != m_macros.end())
+            { // Guarded and included already, contents would be skipped entirely anyways.
+                m_visited.insert(physical);
+                return "\n";
+            }
             preprocessorfileinfo otherfinfo(*include_path_info);
-            otherfinfo.content = runtime.fileio().read_file(*include_path_info);
+            otherfinfo.content = include_file->contents;
 
 
             std::string output;
@@ -770,11 +781,12 @@ std::string sqf::parser::preprocessor::impl_default::instance::parse_ppinstructi
         auto spaceIndex = spaceIter == line.end() ? std::string::npos : std::distance(line.begin(), spaceIter);
         if (bracketsIndex == std::string::npos && spaceIndex == std::string::npos)
         { // Empty define
-            if (try_get_macro(line).has_value())
+            if (try_get_macro(line))
             {
                 log(err::MacroDefinedTwice(fileinfo.to_diag_info(), line));
             }
             m_macros[line] = { fileinfo, line };
+            m_expansions.clear();
 #ifdef DF__SQF_PREPROC__TRACE_MACRO_PARSE
             std::cout << "\x1B[33m[PP-DEFINE-PARSE]\033[0m" <<
                 "        " <<
@@ -787,12 +799,13 @@ std::string sqf::parser::preprocessor::impl_default::instance::parse_ppinstructi
             if (spaceIndex < bracketsIndex || bracketsIndex == std::string::npos) // std::string::npos does not need to be catched as bracketsIndex always < npos here
             { // First bracket was found after first space OR is not existing thus we have a simple define with a replace value here
                 auto name_tmp = line.substr(0, spaceIndex);
-                if (try_get_macro(name_tmp).has_value())
+                if (try_get_macro(name_tmp))
                 {
                     log(err::MacroDefinedTwice(fileinfo.to_diag_info(), name_tmp));
                 }
                 std::string content(trim(line.substr(line[spaceIndex] == ' ' ? spaceIndex + 1 : spaceIndex))); // Special magic for '#define macro\'
                 m_macros[name_tmp] = { fileinfo, name_tmp, content };
+                m_expansions.clear();
 #ifdef DF__SQF_PREPROC__TRACE_MACRO_PARSE
                 std::cout << "\x1B[33m[PP-DEFINE-PARSE]\033[0m" <<
                     "        " <<
@@ -803,7 +816,7 @@ std::string sqf::parser::preprocessor::impl_default::instance::parse_ppinstructi
             else
             { // We got a define with arguments here
                 auto name_tmp = line.substr(0, bracketsIndex);
-                if (try_get_macro(name_tmp).has_value())
+                if (try_get_macro(name_tmp))
                 {
                     log(err::MacroDefinedTwice(fileinfo.to_diag_info(), name_tmp));
                 }
@@ -842,6 +855,7 @@ std::string sqf::parser::preprocessor::impl_default::instance::parse_ppinstructi
                 }
 
                 m_macros[name_tmp] = { fileinfo, name_tmp, args, content };
+                m_expansions.clear();
 #ifdef DF__SQF_PREPROC__TRACE_MACRO_PARSE
                 std::cout << "\x1B[33m[PP-DEFINE-PARSE]\033[0m" <<
                     "        " <<
@@ -867,6 +881,7 @@ std::string sqf::parser::preprocessor::impl_default::instance::parse_ppinstructi
         else
         {
             m_macros.erase(res);
+            m_expansions.clear();
         }
         return "\n";
     }
@@ -983,10 +998,13 @@ std::string sqf::parser::preprocessor::impl_default::instance::parse_file(::sqf:
 {
     push_path(fileinfo.pathinf);
     char c;
-    std::stringstream sstream;
-    std::stringstream wordstream;
+    std::string output;
+    std::string word;
     std::unordered_map<std::string, std::string> empty_parammap;
-    sstream << "#line 0 \"" << fileinfo.pathinf.physical << "\"\n";
+    output.reserve(fileinfo.content.size() + fileinfo.pathinf.physical.size() + 11);
+    output.append("#line 0 \"");
+    output.append(fileinfo.pathinf.physical);
+    output.append("\"\n");
     bool was_new_line = true;
     bool is_in_string = false;
     while ((c = fileinfo.next()) != '\0')
@@ -998,7 +1016,7 @@ std::string sqf::parser::preprocessor::impl_default::instance::parse_file(::sqf:
                 is_in_string = false;
             }
             if (current_file_scope().conditions.empty() || current_file_scope().conditions.back().allow_write)
-                sstream << c;
+                output.push_back(c);
             continue;
         }
         switch (c)
@@ -1006,10 +1024,12 @@ std::string sqf::parser::preprocessor::impl_default::instance::parse_file(::sqf:
             case '"':
             {
                 is_in_string = true;
-                auto word = wordstream.str();
-                wordstream.str("");
                 if (current_file_scope().conditions.empty() || current_file_scope().conditions.back().allow_write)
-                    sstream << word << c;
+                {
+                    output.append(word);
+                    output.push_back(c);
+                }
+                word.clear();
             } break;
             case '\n':
             {
@@ -1025,7 +1045,7 @@ std::string sqf::parser::preprocessor::impl_default::instance::parse_file(::sqf:
                     {
                         return res;
                     }
-                    sstream << res;
+                    output.append(res);
                     break;
                 }
             }
@@ -1037,34 +1057,35 @@ std::string sqf::parser::preprocessor::impl_default::instance::parse_file(::sqf:
                 }
                 if (current_file_scope().conditions.empty() || current_file_scope().conditions.back().allow_write)
                 {
-                    if (wordstream.tellp() > 0)
+                    if (!word.empty())
                     {
-                        auto word = wordstream.str();
-                        wordstream.str("");
                         auto m = try_get_macro(word);
-                        if (m.has_value())
+                        if (m)
                         {
+                            word.clear();
                             fileinfo.move_back();
-                            auto res = handle_macro(runtime, fileinfo, fileinfo, m.value(), empty_parammap);
+                            auto res = handle_macro(runtime, fileinfo, fileinfo, *m, empty_parammap);
                             if (m_errflag)
                             {
                                 return res;
                             }
-                            sstream << res;
+                            output.append(res);
                         }
                         else
                         {
-                            sstream << word << c;
+                            output.append(word);
+                            output.push_back(c);
+                            word.clear();
                         }
                     }
                     else
                     {
-                        sstream << c;
+                        output.push_back(c);
                     }
                 }
                 else if (c == '\n')
                 {
-                    sstream << c;
+                    output.push_back(c);
                 }
             } break;
             case 'a': case 'b': case 'c': case 'd': case 'e':
@@ -1082,33 +1103,32 @@ std::string sqf::parser::preprocessor::impl_default::instance::parse_file(::sqf:
             case '8': case '9': case '_':
             {
                 if (current_file_scope().conditions.empty() || current_file_scope().conditions.back().allow_write)
-                    wordstream << c;
+                    word.push_back(c);
                 was_new_line = false;
             } break;
         }
     }
 
-    auto word = wordstream.str();
     if (!word.empty())
     {
         auto m = try_get_macro(word);
-        if (m.has_value())
+        if (m)
         {
             fileinfo.move_back();
-            auto res = handle_macro(runtime, fileinfo, fileinfo, m.value(), empty_parammap);
+            auto res = handle_macro(runtime, fileinfo, fileinfo, *m, empty_parammap);
             if (m_errflag)
             {
                 return res;
             }
-            sstream << res;
+            output.append(res);
         }
         else
         {
-            sstream << word;
+            output.append(word);
         }
     }
     pop_path(fileinfo);
-    return sstream.str();
+    return output;
 }
 
 std::string line_macro_callback(
@@ -1127,7 +1147,7 @@ std::string file_macro_callback(
     const std::vector<std::string>& params,
     ::sqf::runtime::runtime& runtime)
 {
-    return "\""s + dinf.path.physical + "\""s;
+    return "\""s + dinf.path().physical + "\""s;
 }
 std::string eval_macro_callback(
     const ::sqf::runtime::parser::macro& m,
@@ -1147,25 +1167,14 @@ std::string eval_macro_callback(
     auto res = runtime.evaluate_expression(params[0], success, false);
     return success ? res.data()->to_string_sqf() : "";
 }
-static int __counter__ = 0;
-std::string counter_macro_callback(
-    const ::sqf::runtime::parser::macro& m,
-    const ::sqf::runtime::diagnostics::diag_info dinf,
-    const ::sqf::runtime::fileio::pathinfo local,
-    const std::vector<std::string>& params,
-    ::sqf::runtime::runtime& runtime)
+sqf::parser::preprocessor::impl_default::instance::instance(impl_default* owner, Logger& logger, std::unordered_map<std::string, ::sqf::runtime::parser::macro> macros) :
+    CanLog(logger),
+    m_owner(owner),
+    m_macros(macros)
 {
-    return std::to_string(__counter__++);
-}
-std::string counter_reset_macro_callback(
-    const ::sqf::runtime::parser::macro& m,
-    const ::sqf::runtime::diagnostics::diag_info dinf,
-    const ::sqf::runtime::fileio::pathinfo local,
-    const std::vector<std::string>& params,
-    ::sqf::runtime::runtime& runtime)
-{
-    __counter__ = 0;
-    return "";
+    // Bound to this instance, thus the counter macros must not be handed out beyond its lifetime.
+    m_macros["__COUNTER__"s] = { "__COUNTER__"s, [this](auto&&...) { return std::to_string(m_counter++); } };
+    m_macros["__COUNTER_RESET__"s] = { "__COUNTER_RESET__"s, [this](auto&&...) { m_counter = 0; return ""s; } };
 }
 
 
@@ -1184,6 +1193,131 @@ void sqf::parser::preprocessor::impl_default::instance::pop_path(preprocessorfil
     }
     m_file_scopes.pop_back();
 }
+// Detects include guards, meaning files of the form:
+//     #ifndef NAME
+//     #define NAME
+//     ...
+//     #endif
+// with nothing but whitespace and comments outside, returning NAME.
+static std::optional<std::string> detect_include_guard(std::string_view contents)
+{
+    // Collect the preprocessor instructions of all lines that are not empty after stripping comments.
+    // Lines with something else than an instruction are collected as empty string.
+    std::vector<std::string> lines;
+    bool is_in_block_comment = false;
+    bool is_in_string = false;
+    std::string line;
+    auto flush = [&]() {
+        auto trimmed = trim(line);
+        if (!trimmed.empty())
+        {
+            lines.emplace_back(trimmed[0] == '#' ? std::string(trimmed) : std::string());
+        }
+        line.clear();
+    };
+    for (size_t i = 0; i < contents.length(); i++)
+    {
+        char c = contents[i];
+        char pc = i + 1 < contents.length() ? contents[i + 1] : '\0';
+        if (is_in_block_comment)
+        {
+            if (c == '*' && pc == '/') { is_in_block_comment = false; i++; line.push_back(' '); }
+            else if (c == '\n') { flush(); }
+            continue;
+        }
+        if (!is_in_string && c == '/' && pc == '*') { is_in_block_comment = true; i++; continue; }
+        if (!is_in_string && c == '/' && pc == '/')
+        {
+            while (i + 1 < contents.length() && contents[i + 1] != '\n') { i++; }
+            continue;
+        }
+        if (c == '"') { is_in_string = !is_in_string; }
+        if (c == '\n') { is_in_string = false; flush(); continue; }
+        line.push_back(c == '\r' || c == '\t' ? ' ' : c);
+    }
+    flush();
+
+    // Splits "#  instruction argument" into its upper case instruction and its argument.
+    auto split = [](const std::string& l) -> std::pair<std::string, std::string> {
+        std::string_view view(l);
+        view.remove_prefix(1);
+        auto rest = trim(view);
+        auto end = std::find_if(rest.begin(), rest.end(), [](char c) { return !(std::isalnum((unsigned char)c) || c == '_'); });
+        std::string inst(rest.begin(), end);
+        std::transform(inst.begin(), inst.end(), inst.begin(), [](char c) { return (char)std::toupper((unsigned char)c); });
+        std::string_view arg(rest);
+        arg.remove_prefix((size_t)std::distance(rest.begin(), end));
+        arg = trim(arg);
+        auto arg_end = std::find_if(arg.begin(), arg.end(), [](char c) { return !(std::isalnum((unsigned char)c) || c == '_'); });
+        return { inst, std::string(arg.begin(), arg_end) };
+    };
+
+    if (lines.size() < 3 || lines[0].empty() || lines[1].empty() || lines.back().empty())
+    {
+        return {};
+    }
+    auto [ifndef, name] = split(lines[0]);
+    auto [define, define_name] = split(lines[1]);
+    if (ifndef != "IFNDEF" || define != "DEFINE" || name.empty() || name != define_name)
+    {
+        return {};
+    }
+    // The #endif closing the #ifndef has to be the very last instruction.
+    size_t depth = 0;
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+        if (lines[i].empty()) { continue; }
+        auto inst = split(lines[i]).first;
+        if (inst == "IF" || inst == "IFDEF" || inst == "IFNDEF")
+        {
+            depth++;
+        }
+        else if (inst == "ELSE" && depth == 1)
+        {
+            return {};
+        }
+        else if (inst == "ENDIF")
+        {
+            if (depth == 0 || (--depth == 0 && i + 1 != lines.size()))
+            {
+                return {};
+            }
+        }
+    }
+    if (depth != 0)
+    {
+        return {};
+    }
+    return name;
+}
+
+std::shared_ptr<const sqf::parser::preprocessor::impl_default::include_file> sqf::parser::preprocessor::impl_default::load_include_file(
+    ::sqf::runtime::runtime& runtime,
+    const ::sqf::runtime::fileio::pathinfo& pathinfo)
+{
+    // Files not on disk (eg. inside of a PBO) have no write time and are kept for as long as the preprocessor lives.
+    std::error_code ec;
+    auto last_write_time = std::filesystem::last_write_time(pathinfo.physical, ec);
+    if (ec)
+    {
+        last_write_time = std::filesystem::file_time_type::min();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_include_files_mutex);
+        auto res = m_include_files.find(pathinfo.physical);
+        if (res != m_include_files.end() && res->second->last_write_time == last_write_time)
+        {
+            return res->second;
+        }
+    }
+    auto file = std::make_shared<include_file>();
+    file->last_write_time = last_write_time;
+    file->contents = runtime.fileio().read_file(pathinfo);
+    file->guard = detect_include_guard(file->contents);
+    std::lock_guard<std::mutex> lock(m_include_files_mutex);
+    m_include_files[pathinfo.physical] = file;
+    return file;
+}
 sqf::parser::preprocessor::impl_default::impl_default(Logger& logger) : CanLog(logger)
 {
     // m_macros["__DATE_ARR__"s] = { "__DATE_ARR__"s, counter_macro_callback }; // 2020,10,28,15,17,42
@@ -1203,8 +1337,6 @@ sqf::parser::preprocessor::impl_default::impl_default(Logger& logger) : CanLog(l
     m_macros["__GAME_VER_MAJ__"s] = { "__GAME_VER_MAJ__"s, STR(SQFVM_RUNTIME_VERSION_MAJOR) };
     m_macros["__GAME_VER_MIN__"s] = { "__GAME_VER_MIN__"s, STR(SQFVM_RUNTIME_VERSION_MINOR) };
     m_macros["__GAME_BUILD__"s] = { "__GAME_BUILD__"s, STR(SQFVM_RUNTIME_VERSION_REVISION) };
-    m_macros["__COUNTER__"s] = { "__COUNTER__"s, counter_macro_callback };
-    m_macros["__COUNTER_RESET__"s] = { "__COUNTER_RESET__"s, counter_reset_macro_callback };
     m_macros["__FILE__"s] = { "__FILE__"s, file_macro_callback };
     m_macros["__LINE__"s] = { "__LINE__"s, line_macro_callback };
     m_macros["__EXEC"s] = { "__EXEC"s, { "EXPRESSION"s }, eval_macro_callback };
@@ -1240,6 +1372,11 @@ std::optional<std::string> sqf::parser::preprocessor::impl_default::preprocess(
     {
         for (auto entry : i.m_macros)
         {
+            // The counter macros are bound to the instance, which is gone after returning.
+            if (entry.first == "__COUNTER__"s || entry.first == "__COUNTER_RESET__"s)
+            {
+                continue;
+            }
             out_macros->push_back(entry.second);
         }
     }
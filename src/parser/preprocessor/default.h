@@ -9,6 +9,9 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <optional>
+#include <filesystem>
+#include <memory>
+#include <mutex>
 
 
 namespace sqf::parser::preprocessor
@@ -53,17 +56,40 @@ namespace sqf::parser::preprocessor
                 is_in_block_comment = false;
             }
             preprocessorfileinfo(::sqf::runtime::diagnostics::diag_info dinf)
-                : pathinf(dinf.path)
+                : pathinf(dinf.path())
             {
                 last_col = 0;
                 is_in_string = false;
                 is_in_block_comment = false;
             }
-            std::string content;
+            // The contents scanned. Not owned, the contents have to outlive this.
+            std::string_view content;
             size_t off = 0;
             size_t line = 1;
             size_t col = 0;
             ::sqf::runtime::fileio::pathinfo pathinf;
+
+            // Scanning state, allowing to look ahead without copying the whole preprocessorfileinfo.
+            struct state
+            {
+                size_t off;
+                size_t line;
+                size_t col;
+                size_t last_col;
+                bool is_in_string;
+                bool is_in_block_comment;
+            };
+            state save() const { return { off, line, col, last_col, is_in_string, is_in_block_comment }; }
+            void restore(const state& s)
+            {
+                off = s.off;
+                line = s.line;
+                col = s.col;
+                last_col = s.last_col;
+                is_in_string = s.is_in_string;
+                is_in_block_comment = s.is_in_block_comment;
+            }
+
             // Returns the next character.
             // Will not take into account to skip eg. comments or simmilar things!
             char peek(size_t len = 0)
@@ -153,7 +179,7 @@ namespace sqf::parser::preprocessor
                     off_end = off;
                 }
                 move_back();
-                return content.substr(off_start, off_end - off_start);
+                return std::string(content.substr(off_start, off_end - off_start));
             }
 
             std::string get_line(bool catchEscapedNewLine)
@@ -197,7 +223,7 @@ namespace sqf::parser::preprocessor
                 {
                     while ((c = next()) != '\0' && c != '\n') {}
                 }
-                return content.substr(off_start, off - off_start);
+                return std::string(content.substr(off_start, off - off_start));
             }
             // Moves one character backwards and updates
             // porgression of line, col and off according
@@ -232,6 +258,22 @@ namespace sqf::parser::preprocessor
     private:
         std::unordered_map<std::string, ::sqf::runtime::parser::macro> m_macros;
         std::unordered_map<std::string, ::sqf::runtime::parser::pragma> m_pragmas;
+        struct include_file
+        {
+            std::filesystem::file_time_type last_write_time;
+            std::string contents;
+            // Name of the macro guarding the whole file (#ifndef X / #define X / ... / #endif), if any.
+            std::optional<std::string> guard;
+        };
+        // Contents of included files by physical path, kept until the file changes on disk.
+        // Guarded by m_include_files_mutex, as files may be preprocessed concurrently.
+        std::unordered_map<std::string, std::shared_ptr<const include_file>> m_include_files;
+        std::mutex m_include_files_mutex;
+
+        /// <summary>
+        /// Receives the contents of the provided include file, reading it only if not cached already or changed since.
+        /// </summary>
+        std::shared_ptr<const include_file> load_include_file(::sqf::runtime::runtime& runtime, const ::sqf::runtime::fileio::pathinfo& pathinfo);
         struct condition_scope
         {
             bool allow_write;
@@ -246,12 +288,21 @@ namespace sqf::parser::preprocessor
         class instance : public CanLog
         {
         public:
-            instance(impl_default* owner, Logger& logger, std::unordered_map<std::string, ::sqf::runtime::parser::macro> macros) : CanLog(logger), m_owner(owner), m_macros(macros) {};
+            instance(impl_default* owner, Logger& logger, std::unordered_map<std::string, ::sqf::runtime::parser::macro> macros);
+            instance(const instance&) = delete;
+            instance& operator=(const instance&) = delete;
             std::vector<file_scope> m_file_scopes;
             std::unordered_set<std::string> m_visited;
             bool m_errflag = false;
             impl_default* m_owner;
             std::unordered_map<std::string, ::sqf::runtime::parser::macro> m_macros;
+            // Fully expanded macros, by macro name and arguments. Cleared whenever a macro gets (un)defined.
+            std::unordered_map<std::string, std::string> m_expansions;
+            // Set if the current expansion must not be memoised, eg. because it depends on a callback macro.
+            bool m_volatile = false;
+            // Value of __COUNTER__. Counted per preprocessed file (like per translation unit in C),
+            // hence files preprocessed concurrently or by different runtimes do not affect each other.
+            int m_counter = 0;
 
             void replace_stringify(
                 ::sqf::runtime::runtime& runtime,
@@ -259,7 +310,7 @@ namespace sqf::parser::preprocessor
                 preprocessorfileinfo& original_fileinfo,
                 const ::sqf::runtime::parser::macro& m,
                 std::vector<std::string>& params,
-                std::stringstream& sstream,
+                std::string& output,
                 const std::unordered_map<std::string, std::string>& param_map);
 
             void replace_concat(
@@ -268,7 +319,7 @@ namespace sqf::parser::preprocessor
                 preprocessorfileinfo& original_fileinfo,
                 const ::sqf::runtime::parser::macro& m,
                 std::vector<std::string>& params,
-                std::stringstream& sstream,
+                std::string& output,
                 const std::unordered_map<std::string, std::string>& param_map);
 
             std::string handle_macro(
@@ -295,9 +346,9 @@ namespace sqf::parser::preprocessor
 
             std::string parse_file(::sqf::runtime::runtime& runtime, preprocessorfileinfo& fileinfo);
 
-            size_t replace_find_wordend(::sqf::runtime::runtime& runtime, preprocessorfileinfo fileinfo);
+            size_t replace_find_wordend(::sqf::runtime::runtime& runtime, preprocessorfileinfo& fileinfo);
 
-            void replace_skip(::sqf::runtime::runtime& runtime, preprocessorfileinfo& fileinfo, std::stringstream& sstream);
+            void replace_skip(::sqf::runtime::runtime& runtime, preprocessorfileinfo& fileinfo, std::string& output);
 
             bool allow_write() const { return m_file_scopes.back().conditions.empty() || m_file_scopes.back().conditions.back().allow_write; }
             bool errflag() { return m_errflag; }
@@ -305,14 +356,14 @@ namespace sqf::parser::preprocessor
             void push_path(const ::sqf::runtime::fileio::pathinfo pathinfo);
             void pop_path(preprocessorfileinfo& preprocessorfileinfo);
 
-            std::optional<::sqf::runtime::parser::macro> try_get_macro(const std::string macro_name) const
+            const ::sqf::runtime::parser::macro* try_get_macro(const std::string& macro_name) const
             {
                 auto res = m_macros.find(macro_name);
                 if (res == m_macros.end())
                 {
-                    return {};
+                    return nullptr;
                 }
-                return res->second;
+                return &res->second;
             }
         };
     public:
@@ -0,0 +1,289 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if !defined(DF__SQF_PARSER__SCANNER_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define SQF_PARSER_SCANNER_SSE2
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+/// <summary>
+/// Character classification and scanning routines shared by the sqf, config and assembly tokenizers.
+/// All functions take the range [it, end) and return the first character not consumed,
+/// using SSE2 (if available) for the runs that commonly are long: identifiers, whitespace, comments and string bodies.
+/// </summary>
+namespace sqf::parser::scanner
+{
+    enum cclass : uint8_t
+    {
+        none = 0,
+        alpha = 1 << 0,
+        digit = 1 << 1,
+        underscore = 1 << 2,
+        hex = 1 << 3,
+        whitespace = 1 << 4,
+
+        ident = alpha | digit | underscore
+    };
+
+    constexpr std::array<uint8_t, 256> make_table()
+    {
+        std::array<uint8_t, 256> table{};
+        for (int c = 'a'; c <= 'z'; c++) { table[c] |= alpha; }
+        for (int c = 'A'; c <= 'Z'; c++) { table[c] |= alpha; }
+        for (int c = '0'; c <= '9'; c++) { table[c] |= digit | hex; }
+        for (int c = 'a'; c <= 'f'; c++) { table[c] |= hex; }
+        for (int c = 'A'; c <= 'F'; c++) { table[c] |= hex; }
+        table['_'] |= underscore;
+        table[' '] |= whitespace;
+        table['\t'] |= whitespace;
+        table['\r'] |= whitespace;
+        table['\n'] |= whitespace;
+        return table;
+    }
+    inline constexpr std::array<uint8_t, 256> table = make_table();
+
+    inline bool is(char c, uint8_t mask) { return (table[(uint8_t)c] & mask) != 0; }
+    inline char lower(char c) { return is(c, alpha) ? (char)(c | 0x20) : c; }
+
+    /// <summary>
+    /// Skips all characters of the provided class.
+    /// </summary>
+    inline const char* span(const char* it, const char* end, uint8_t mask)
+    {
+        while (it != end && is(*it, mask)) { ++it; }
+        return it;
+    }
+
+#if defined(SQF_PARSER_SCANNER_SSE2)
+    inline unsigned first_bit(unsigned mask)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return (unsigned)index;
+#else
+        return (unsigned)__builtin_ctz(mask);
+#endif
+    }
+    inline __m128i load(const char* it) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(it)); }
+    inline __m128i in_range(__m128i v, char from, char to)
+    { // Signed compare, hence only valid for ranges inside of 0x00 - 0x7F
+        return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8((char)(from - 1))), _mm_cmplt_epi8(v, _mm_set1_epi8((char)(to + 1))));
+    }
+#endif
+
+    /// <summary>
+    /// Skips [a-zA-Z0-9_].
+    /// </summary>
+    inline const char* span_ident(const char* it, const char* end)
+    {
+#if defined(SQF_PARSER_SCANNER_SSE2)
+        while (end - it >= 16)
+        {
+            auto v = load(it);
+            auto matches = _mm_or_si128(
+                _mm_or_si128(in_range(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 'z'), in_range(v, '0', '9')),
+                _mm_cmpeq_epi8(v, _mm_set1_epi8('_')));
+            auto mask = ~(unsigned)_mm_movemask_epi8(matches) & 0xFFFF;
+            if (mask) { return it + first_bit(mask); }
+            it += 16;
+        }
+#endif
+        return span(it, end, ident);
+    }
+
+    /// <summary>
+    /// Skips ' ', '\t', '\r' and '\n'.
+    /// </summary>
+    inline const char* span_whitespace(const char* it, const char* end)
+    {
+#if defined(SQF_PARSER_SCANNER_SSE2)
+        while (end - it >= 16)
+        {
+            auto v = load(it);
+            auto matches = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))),
+                _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\t')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+            auto mask = ~(unsigned)_mm_movemask_epi8(matches) & 0xFFFF;
+            if (mask) { return it + first_bit(mask); }
+            it += 16;
+        }
+#endif
+        return span(it, end, whitespace);
+    }
+
+    /// <summary>
+    /// Finds the first occurance of c or end.
+    /// </summary>
+    inline const char* find(const char* it, const char* end, char c)
+    {
+        if (it == end) { return end; }
+        auto res = static_cast<const char*>(std::memchr(it, c, (size_t)(end - it)));
+        return res ? res : end;
+    }
+
+    /// <summary>
+    /// Finds the first occurance of either a or b or end.
+    /// </summary>
+    inline const char* find(const char* it, const char* end, char a, char b)
+    {
+#if defined(SQF_PARSER_SCANNER_SSE2)
+        while (end - it >= 16)
+        {
+            auto v = load(it);
+            auto mask = (unsigned)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(a)), _mm_cmpeq_epi8(v, _mm_set1_epi8(b))));
+            if (mask) { return it + first_bit(mask); }
+            it += 16;
+        }
+#endif
+        for (; it != end; ++it)
+        {
+            if (*it == a || *it == b) { return it; }
+        }
+        return end;
+    }
+
+    /// <summary>
+    /// Case-insensitive match of a lowercase keyword, not directly followed by another letter.
+    /// </summary>
+    /// <returns>The end of the keyword or it if not matching.</returns>
+    template<size_t N>
+    const char* keyword(const char* it, const char* end, const char(&against)[N])
+    {
+        constexpr size_t len = N - 1;
+        if ((size_t)(end - it) < len) { return it; }
+        for (size_t i = 0; i < len; i++)
+        {
+            if (lower(it[i]) != against[i]) { return it; }
+        }
+        if (it + len != end && is(it[len], alpha)) { return it; }
+        return it + len;
+    }
+
+    /// <summary>
+    /// Skips whitespace, updating line and column.
+    /// </summary>
+    inline const char* skip_whitespace(const char* it, const char* end, size_t& line, size_t& column)
+    {
+        auto last = span_whitespace(it, end);
+        for (; it != last; ++it)
+        {
+            if (*it == '\n') { line++; column = 0; }
+            else { column++; }
+        }
+        return last;
+    }
+
+    /// <summary>
+    /// Skips a line comment (excluding the terminating '\n').
+    /// </summary>
+    /// <returns>The end of the comment or it if there is no line comment at it.</returns>
+    inline const char* skip_comment_line(const char* it, const char* end, size_t& line, size_t& column)
+    {
+        if (end - it < 2 || it[0] != '/' || it[1] != '/') { return it; }
+        // The terminating '\n' is still counted here, as before.
+        line++;
+        column = 0;
+        return find(it + 2, end, '\n');
+    }
+
+    /// <summary>
+    /// Skips a block comment, including the terminating '*' '/'.
+    /// </summary>
+    /// <returns>The end of the comment or it if there is no block comment at it.</returns>
+    inline const char* skip_comment_block(const char* it, const char* end, size_t& line, size_t& column)
+    {
+        if (end - it < 2 || it[0] != '/' || it[1] != '*') { return it; }
+        it += 2;
+        column += 2;
+        while (true)
+        {
+            auto next = find(it, end, '*', '\n');
+            column += (size_t)(next - it);
+            if (next == end)
+            {
+                return end;
+            }
+            if (*next == '\n')
+            {
+                line++;
+                column = 0;
+            }
+            else if (next + 1 != end && next[1] == '/')
+            {
+                column += 2;
+                return next + 2;
+            }
+            else
+            {
+                column++;
+            }
+            it = next + 1;
+        }
+    }
+
+    /// <summary>
+    /// Skips a string enclosed in quote, where a doubled quote is part of the string.
+    /// Expects it to point to the opening quote. Unterminated strings end at end.
+    /// </summary>
+    inline const char* skip_string(const char* it, const char* end, char quote, size_t& line, size_t& column)
+    {
+        ++it;
+        column++;
+        while (true)
+        {
+            auto next = find(it, end, quote, '\n');
+            column += (size_t)(next - it);
+            if (next == end)
+            {
+                return end;
+            }
+            column++;
+            if (*next == '\n')
+            {
+                line++;
+                column = 0;
+                it = next + 1;
+            }
+            else if (next + 1 != end && next[1] == quote)
+            {
+                column++;
+                it = next + 2;
+            }
+            else
+            {
+                return next + 1;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Skips a hexadecimal number in either the '$' 'F' 'F' or '0' 'x' 'F' 'F' notation.
+    /// </summary>
+    /// <returns>The end of the number or it if there is no hexadecimal number at it.</returns>
+    inline const char* skip_hexadecimal(const char* it, const char* end)
+    {
+        auto start = it;
+        if (it == end) { return start; }
+        if (*it == '$')
+        {
+            ++it;
+        }
+        else if (*it == '0' && it + 1 != end && it[1] == 'x')
+        {
+            it += 2;
+        }
+        else
+        {
+            return start;
+        }
+        auto last = span(it, end, hex);
+        return last == it ? start : last;
+    }
+}
@@ -0,0 +1,179 @@
+#include "sqf_optimizer.hpp"
+
+#include "../../opcodes/common.h"
+#include "../../runtime/runtime.h"
+#include "../../runtime/sqfop.h"
+#include "../../runtime/d_scalar.h"
+#include "../../runtime/d_string.h"
+#include "../../runtime/d_boolean.h"
+#include "../../runtime/d_array.h"
+#include "../../runtime/d_code.h"
+
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string_view>
+
+using namespace std::string_view_literals;
+
+namespace
+{
+    // Operators that neither depend on nor modify any state when called with SCALAR, STRING or BOOL operands.
+    const std::array pure_binary = {
+        "+"sv, "-"sv, "*"sv, "/"sv, "%"sv, "mod"sv, "^"sv, "min"sv, "max"sv, "atan2"sv,
+        ">"sv, ">="sv, "<"sv, "<="sv, "=="sv, "!="sv, "&&"sv, "||"sv, "and"sv, "or"sv,
+        "isequalto"sv, "isnotequalto"sv, "isequaltype"sv, "find"sv
+    };
+    const std::array pure_unary = {
+        "-"sv, "+"sv, "!"sv, "not"sv, "abs"sv, "deg"sv, "rad"sv, "sin"sv, "cos"sv, "tan"sv,
+        "asin"sv, "acos"sv, "atan"sv, "atg"sv, "exp"sv, "ln"sv, "log"sv, "sqrt"sv, "floor"sv,
+        "ceil"sv, "round"sv, "count"sv, "tolower"sv, "toupper"sv, "parsenumber"sv
+    };
+    template<size_t N>
+    bool is_pure(const std::array<std::string_view, N>& names, std::string_view name)
+    {
+        return std::find(names.begin(), names.end(), name) != names.end();
+    }
+
+    // Operands that may get folded.
+    bool is_literal(sqf::runtime::value::cref val)
+    {
+        return val.is<sqf::runtime::t_scalar>() || val.is<sqf::runtime::t_string>() || val.is<sqf::runtime::t_boolean>();
+    }
+    const sqf::opcodes::push* as_push(const sqf::runtime::instruction::sptr& inst)
+    {
+        return dynamic_cast<const sqf::opcodes::push*>(inst.get());
+    }
+    bool is_end_statement(const sqf::runtime::instruction::sptr& inst)
+    {
+        return dynamic_cast<const sqf::opcodes::end_statement*>(inst.get()) != nullptr;
+    }
+    // Elements that may be part of a constant array.
+    bool is_constant_element(const sqf::runtime::instruction::sptr& inst)
+    {
+        auto push = as_push(inst);
+        if (!push)
+        {
+            return false;
+        }
+        return dynamic_cast<const sqf::opcodes::push_array*>(push) != nullptr || is_literal(push->value()) || push->value().is<sqf::runtime::t_code>();
+    }
+
+    void replace_tail(std::vector<sqf::runtime::instruction::sptr>& out, size_t count, sqf::runtime::instruction::sptr inst)
+    {
+        inst->diag_info(out.back()->diag_info());
+        out.resize(out.size() - count);
+        out.push_back(inst);
+    }
+
+    bool fold_binary(sqf::runtime::runtime& runtime, std::vector<sqf::runtime::instruction::sptr>& out)
+    {
+        auto call = dynamic_cast<const sqf::opcodes::call_binary*>(out.back().get());
+        if (!call || out.size() < 3 || !is_pure(pure_binary, call->operator_name()))
+        {
+            return false;
+        }
+        auto left = as_push(out[out.size() - 3]);
+        auto right = as_push(out[out.size() - 2]);
+        if (!left || !right || !is_literal(left->value()) || !is_literal(right->value()))
+        {
+            return false;
+        }
+        auto op = runtime.sqfop_resolve_binary(std::string(call->operator_name()))->at(left->value().type(), right->value().type());
+        if (!op)
+        {
+            return false;
+        }
+        if (call->operator_name() == "/"sv && right->value().is<sqf::runtime::t_scalar>() &&
+            std::abs(right->value().data<sqf::types::d_scalar, ::sqf::runtime::scalar_t>()) <= std::numeric_limits<::sqf::runtime::scalar_t>::epsilon())
+        { // Division by zero has to be reported at runtime
+            return false;
+        }
+        auto res = op->execute(runtime, left->value(), right->value());
+        if (!is_literal(res))
+        {
+            return false;
+        }
+        replace_tail(out, 3, std::make_shared<sqf::opcodes::push>(res));
+        return true;
+    }
+
+    bool fold_unary(sqf::runtime::runtime& runtime, std::vector<sqf::runtime::instruction::sptr>& out)
+    {
+        auto call = dynamic_cast<const sqf::opcodes::call_unary*>(out.back().get());
+        if (!call || out.size() < 2 || !is_pure(pure_unary, call->operator_name()))
+        {
+            return false;
+        }
+        auto right = as_push(out[out.size() - 2]);
+        if (!right || !is_literal(right->value()))
+        {
+            return false;
+        }
+        auto op = runtime.sqfop_resolve_unary(std::string(call->operator_name()))->at(right->value().type());
+        if (!op)
+        {
+            return false;
+        }
+        auto res = op->execute(runtime, right->value());
+        if (!is_literal(res))
+        {
+            return false;
+        }
+        replace_tail(out, 2, std::make_shared<sqf::opcodes::push>(res));
+        return true;
+    }
+
+    bool fold_array(std::vector<sqf::runtime::instruction::sptr>& out)
+    {
+        auto make = dynamic_cast<const sqf::opcodes::make_array*>(out.back().get());
+        if (!make || out.size() < make->array_size() + 1)
+        {
+            return false;
+        }
+        auto begin = out.end() - 1 - make->array_size();
+        auto end = out.end() - 1;
+        if (!std::all_of(begin, end, is_constant_element))
+        {
+            return false;
+        }
+        std::vector<sqf::runtime::value> values;
+        values.reserve(make->array_size());
+        for (auto it = begin; it != end; ++it)
+        {
+            values.push_back(as_push(*it)->value());
+        }
+        replace_tail(out, make->array_size() + 1, std::make_shared<sqf::opcodes::push_array>(std::make_shared<sqf::types::d_array>(values)));
+        return true;
+    }
+}
+
+void sqf::parser::sqf::optimize(::sqf::runtime::runtime& runtime, std::vector<::sqf::runtime::instruction::sptr>& set)
+{
+    std::vector<::sqf::runtime::instruction::sptr> out;
+    out.reserve(set.size());
+    for (auto& inst : set)
+    {
+        if (is_end_statement(inst))
+        {
+            // Values of the previous statement get discarded anyways
+            while (!out.empty() && as_push(out.back()))
+            {
+                out.pop_back();
+            }
+            if (out.empty() || is_end_statement(out.back()))
+            {
+                continue;
+            }
+            out.push_back(inst);
+            continue;
+        }
+        out.push_back(inst);
+        if (!fold_binary(runtime, out) && !fold_unary(runtime, out))
+        {
+            fold_array(out);
+        }
+    }
+    set = std::move(out);
+}
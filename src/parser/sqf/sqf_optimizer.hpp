@@ -0,0 +1,25 @@
+#pragma once
+#include "../../runtime/instruction.h"
+
+#include <vector>
+
+namespace sqf::runtime
+{
+    class runtime;
+}
+namespace sqf::parser::sqf
+{
+    /// <summary>
+    /// Optimization pass over the instructions of a single code block,
+    /// performed prior to creating the instruction_set of it.
+    /// Folds pure operators with literal operands, pre-builds arrays made up of constants only
+    /// and removes values that get pushed just to be discarded by the following end_statement.
+    /// </summary>
+    /// <remarks>
+    /// Code blocks get reconstructed from their instructions, hence the string representation
+    /// of optimized code may differ from its source.
+    /// </remarks>
+    /// <param name="runtime">The runtime providing the operators to fold with.</param>
+    /// <param name="set">The instructions to optimize in place.</param>
+    void optimize(::sqf::runtime::runtime& runtime, std::vector<::sqf::runtime::instruction::sptr>& set);
+}
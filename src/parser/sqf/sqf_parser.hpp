@@ -22,7 +22,7 @@ namespace sqf::parser::sqf
     class parser : public ::sqf::runtime::parser::sqf, public CanLog
     {
     private:
-        void to_assembly(std::string_view contents, const ::sqf::parser::sqf::bison::astnode& node, std::vector<::sqf::runtime::instruction::sptr>& set);
+        void to_assembly(::sqf::runtime::runtime& runtime, ::sqf::runtime::diagnostics::source_table& sources, const ::sqf::parser::sqf::bison::astnode& node, std::vector<::sqf::runtime::instruction::sptr>& set);
     public:
         parser(Logger& logger) : CanLog(logger)
         {
@@ -0,0 +1,557 @@
+#include "sqf_precompiled.hpp"
+
+#include "../../opcodes/common.h"
+#include "../../runtime/runtime.h"
+#include "../../runtime/version.h"
+#include "../../runtime/git_sha1.h"
+#include "../../runtime/d_scalar.h"
+#include "../../runtime/d_string.h"
+#include "../../runtime/d_boolean.h"
+#include "../../runtime/d_array.h"
+#include "../../runtime/d_code.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <unordered_map>
+#include <system_error>
+#include <thread>
+
+namespace
+{
+    // Bumped whenever the layout of cache files changes.
+    const char magic[] = "SQFVMPC2";
+
+    enum class kind : uint8_t
+    {
+        end_statement,
+        push,
+        push_array,
+        make_array,
+        call_nular,
+        call_unary,
+        call_binary,
+        get_variable,
+        assign_to,
+        assign_to_local
+    };
+    enum class tag : uint8_t
+    {
+        nil,
+        scalar,
+        boolean,
+        string,
+        code,
+        array
+    };
+
+    uint64_t fnv1a(std::string_view view)
+    {
+        uint64_t hash = 0xcbf29ce484222325;
+        for (auto c : view)
+        {
+            hash ^= (uint8_t)c;
+            hash *= 0x100000001b3;
+        }
+        return hash;
+    }
+
+    class writer
+    {
+    private:
+        std::string m_out;
+        std::unordered_map<std::string, uint32_t> m_string_indices;
+        std::vector<std::string_view> m_strings;
+    public:
+        template<typename T>
+        void integer(T t)
+        {
+            auto u = (uint64_t)t;
+            for (size_t i = 0; i < sizeof(T); i++)
+            {
+                m_out.push_back((char)((u >> (i * 8)) & 0xFF));
+            }
+        }
+        void scalar(double d)
+        {
+            uint64_t u;
+            std::memcpy(&u, &d, sizeof(u));
+            integer(u);
+        }
+        void raw(std::string_view str)
+        {
+            integer((uint32_t)str.size());
+            m_out.append(str);
+        }
+        void string(std::string_view str)
+        {
+            auto res = m_string_indices.emplace(std::string(str), (uint32_t)m_strings.size());
+            if (res.second)
+            {
+                m_strings.push_back(res.first->first);
+            }
+            integer(res.first->second);
+        }
+        bool value(sqf::runtime::value::cref val);
+        bool instructions(const sqf::runtime::instruction_set& set);
+        bool instruction(const sqf::runtime::instruction& inst);
+
+        const std::string& str() const { return m_out; }
+
+        // Prefixes the collected string table to the written instructions.
+        std::string finish()
+        {
+            writer table;
+            table.integer((uint32_t)m_strings.size());
+            for (auto str : m_strings)
+            {
+                table.raw(str);
+            }
+            return table.m_out + m_out;
+        }
+    };
+
+    class reader
+    {
+    private:
+        std::string_view m_in;
+        std::vector<std::string_view> m_strings;
+        std::shared_ptr<const sqf::runtime::fileio::pathinfo> m_path;
+        std::unordered_map<const char*, std::shared_ptr<const std::string>> m_code_segments;
+        bool m_good;
+    public:
+        reader(std::string_view in) : m_in(in), m_good(true) {}
+        bool good() const { return m_good; }
+        bool done() const { return m_in.empty(); }
+
+        template<typename T>
+        T integer()
+        {
+            if (m_in.size() < sizeof(T))
+            {
+                m_good = false;
+                return {};
+            }
+            uint64_t u = 0;
+            for (size_t i = 0; i < sizeof(T); i++)
+            {
+                u |= (uint64_t)(uint8_t)m_in[i] << (i * 8);
+            }
+            m_in.remove_prefix(sizeof(T));
+            return (T)u;
+        }
+        double scalar()
+        {
+            auto u = integer<uint64_t>();
+            double d;
+            std::memcpy(&d, &u, sizeof(d));
+            return d;
+        }
+        std::string_view raw()
+        {
+            auto size = integer<uint32_t>();
+            if (!m_good || m_in.size() < size)
+            {
+                m_good = false;
+                return {};
+            }
+            auto str = m_in.substr(0, size);
+            m_in.remove_prefix(size);
+            return str;
+        }
+        std::string_view string()
+        {
+            auto index = integer<uint32_t>();
+            if (!m_good || index >= m_strings.size())
+            {
+                m_good = false;
+                return {};
+            }
+            return m_strings[index];
+        }
+        void strings()
+        {
+            auto count = integer<uint32_t>();
+            for (uint32_t i = 0; m_good && i < count; i++)
+            {
+                m_strings.push_back(raw());
+            }
+        }
+        sqf::runtime::value value();
+        std::optional<sqf::runtime::instruction_set> instructions();
+        sqf::runtime::instruction::sptr instruction();
+    };
+
+    bool writer::value(sqf::runtime::value::cref val)
+    {
+        if (val.empty())
+        {
+            integer(tag::nil);
+        }
+        else if (val.is<sqf::runtime::t_scalar>())
+        {
+            integer(tag::scalar);
+            scalar(val.data<sqf::types::d_scalar, double>());
+        }
+        else if (val.is<sqf::runtime::t_boolean>())
+        {
+            integer(tag::boolean);
+            integer((uint8_t)val.data<sqf::types::d_boolean, bool>());
+        }
+        else if (val.is<sqf::runtime::t_string>())
+        {
+            integer(tag::string);
+            string(val.data<sqf::types::d_string, std::string_view>());
+        }
+        else if (val.is<sqf::runtime::t_code>())
+        {
+            integer(tag::code);
+            return instructions(val.data<sqf::types::d_code>()->value());
+        }
+        else if (val.is<sqf::runtime::t_array>())
+        {
+            auto arr = val.data<sqf::types::d_array>();
+            integer(tag::array);
+            integer((uint32_t)arr->size());
+            for (auto& it : *arr)
+            {
+                if (!value(it)) { return false; }
+            }
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+    bool writer::instructions(const sqf::runtime::instruction_set& set)
+    {
+        integer((uint32_t)set.size());
+        for (auto& it : set)
+        {
+            if (!instruction(*it)) { return false; }
+        }
+        return true;
+    }
+    bool writer::instruction(const sqf::runtime::instruction& inst)
+    {
+        auto write_diag_info = [&]() {
+            auto& diag_info = inst.diag_info();
+            integer((uint32_t)diag_info.line);
+            integer((uint32_t)diag_info.column);
+            integer((uint64_t)diag_info.adjusted_offset);
+            integer((uint64_t)diag_info.file_offset);
+            integer((uint64_t)diag_info.length);
+            string(diag_info.path().physical);
+            string(diag_info.path().additional);
+            string(diag_info.path().virtual_);
+            string(diag_info.code_segment());
+        };
+        if (dynamic_cast<const sqf::opcodes::end_statement*>(&inst))
+        {
+            integer(kind::end_statement);
+            write_diag_info();
+        }
+        else if (auto push_array = dynamic_cast<const sqf::opcodes::push_array*>(&inst))
+        {
+            integer(kind::push_array);
+            write_diag_info();
+            return value(push_array->value());
+        }
+        else if (auto push = dynamic_cast<const sqf::opcodes::push*>(&inst))
+        {
+            integer(kind::push);
+            write_diag_info();
+            return value(push->value());
+        }
+        else if (auto make_array = dynamic_cast<const sqf::opcodes::make_array*>(&inst))
+        {
+            integer(kind::make_array);
+            write_diag_info();
+            integer((uint64_t)make_array->array_size());
+        }
+        else if (auto call_nular = dynamic_cast<const sqf::opcodes::call_nular*>(&inst))
+        {
+            integer(kind::call_nular);
+            write_diag_info();
+            string(call_nular->operator_name());
+        }
+        else if (auto call_unary = dynamic_cast<const sqf::opcodes::call_unary*>(&inst))
+        {
+            integer(kind::call_unary);
+            write_diag_info();
+            string(call_unary->operator_name());
+        }
+        else if (auto call_binary = dynamic_cast<const sqf::opcodes::call_binary*>(&inst))
+        {
+            integer(kind::call_binary);
+            write_diag_info();
+            string(call_binary->operator_name());
+            integer(call_binary->precedence());
+        }
+        else if (auto get_variable = dynamic_cast<const sqf::opcodes::get_variable*>(&inst))
+        {
+            integer(kind::get_variable);
+            write_diag_info();
+            string(get_variable->variable_name());
+        }
+        else if (auto assign_to = dynamic_cast<const sqf::opcodes::assign_to*>(&inst))
+        {
+            integer(kind::assign_to);
+            write_diag_info();
+            string(assign_to->variable_name());
+        }
+        else if (auto assign_to_local = dynamic_cast<const sqf::opcodes::assign_to_local*>(&inst))
+        {
+            integer(kind::assign_to_local);
+            write_diag_info();
+            string(assign_to_local->variable_name());
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    sqf::runtime::value reader::value()
+    {
+        switch (integer<tag>())
+        {
+        case tag::nil: return {};
+        case tag::scalar: return scalar();
+        case tag::boolean: return integer<uint8_t>() != 0;
+        case tag::string: return std::string(string());
+        case tag::code:
+        {
+            auto set = instructions();
+            if (!set.has_value()) { return {}; }
+            return std::make_shared<sqf::types::d_code>(*set);
+        }
+        case tag::array:
+        {
+            auto count = integer<uint32_t>();
+            std::vector<sqf::runtime::value> values;
+            for (uint32_t i = 0; m_good && i < count; i++)
+            {
+                values.push_back(value());
+            }
+            return values;
+        }
+        default:
+            m_good = false;
+            return {};
+        }
+    }
+    std::optional<sqf::runtime::instruction_set> reader::instructions()
+    {
+        auto count = integer<uint32_t>();
+        std::vector<sqf::runtime::instruction::sptr> set;
+        for (uint32_t i = 0; m_good && i < count; i++)
+        {
+            set.push_back(instruction());
+        }
+        if (!m_good) { return {}; }
+        return sqf::runtime::instruction_set(std::move(set));
+    }
+    sqf::runtime::instruction::sptr reader::instruction()
+    {
+        auto k = integer<kind>();
+        sqf::runtime::diagnostics::diag_info diag_info;
+        diag_info.line = integer<uint32_t>();
+        diag_info.column = integer<uint32_t>();
+        diag_info.adjusted_offset = (size_t)integer<uint64_t>();
+        diag_info.file_offset = (size_t)integer<uint64_t>();
+        diag_info.length = (size_t)integer<uint64_t>();
+        auto physical = string();
+        auto additional = string();
+        auto virtual_ = string();
+        if (!m_path || m_path->physical != physical || m_path->additional != additional || m_path->virtual_ != virtual_)
+        {
+            sqf::runtime::fileio::pathinfo path;
+            path.physical = physical;
+            path.additional = additional;
+            path.virtual_ = virtual_;
+            m_path = std::make_shared<const sqf::runtime::fileio::pathinfo>(std::move(path));
+        }
+        diag_info.path(m_path);
+        // Equal strings share their view, as they are only stored once.
+        auto code_segment = string();
+        auto& shared_code_segment = m_code_segments[code_segment.data()];
+        if (!shared_code_segment)
+        {
+            shared_code_segment = std::make_shared<const std::string>(code_segment);
+        }
+        diag_info.code_segment(shared_code_segment);
+
+        sqf::runtime::instruction::sptr inst;
+        switch (k)
+        {
+        case kind::end_statement: inst = std::make_shared<sqf::opcodes::end_statement>(); break;
+        case kind::push: inst = std::make_shared<sqf::opcodes::push>(value()); break;
+        case kind::push_array:
+        {
+            auto val = value();
+            if (!val.is<sqf::runtime::t_array>()) { m_good = false; return {}; }
+            inst = std::make_shared<sqf::opcodes::push_array>(val.data<sqf::types::d_array>());
+        } break;
+        case kind::make_array: inst = std::make_shared<sqf::opcodes::make_array>((size_t)integer<uint64_t>()); break;
+        case kind::call_nular: inst = std::make_shared<sqf::opcodes::call_nular>(std::string(string())); break;
+        case kind::call_unary: inst = std::make_shared<sqf::opcodes::call_unary>(std::string(string())); break;
+        case kind::call_binary:
+        {
+            auto name = string();
+            auto precedence = integer<short>();
+            inst = std::make_shared<sqf::opcodes::call_binary>(std::string(name), precedence);
+        } break;
+        case kind::get_variable: inst = std::make_shared<sqf::opcodes::get_variable>(string()); break;
+        case kind::assign_to: inst = std::make_shared<sqf::opcodes::assign_to>(string()); break;
+        case kind::assign_to_local: inst = std::make_shared<sqf::opcodes::assign_to_local>(string()); break;
+        default: m_good = false; return {};
+        }
+        inst->diag_info(diag_info);
+        return inst;
+    }
+}
+
+std::optional<std::string> sqf::parser::sqf::serialize(const ::sqf::runtime::instruction_set& set)
+{
+    writer w;
+    if (!w.instructions(set))
+    {
+        return {};
+    }
+    // Suffixed with the checksum of the payload, so that corrupted blobs get rejected
+    // instead of turning into different, but well-formed, instructions.
+    auto payload = w.finish();
+    writer checksum;
+    checksum.integer(fnv1a(payload));
+    return payload + checksum.str();
+}
+
+std::optional<::sqf::runtime::instruction_set> sqf::parser::sqf::deserialize(std::string_view blob)
+{
+    if (blob.size() < sizeof(uint64_t))
+    {
+        return {};
+    }
+    auto payload = blob.substr(0, blob.size() - sizeof(uint64_t));
+    reader checksum(blob.substr(payload.size()));
+    if (checksum.integer<uint64_t>() != fnv1a(payload))
+    {
+        return {};
+    }
+    reader r(payload);
+    r.strings();
+    auto set = r.instructions();
+    if (!r.good() || !r.done())
+    {
+        return {};
+    }
+    return set;
+}
+
+sqf::parser::sqf::precompiled::precompiled(std::unique_ptr<::sqf::runtime::parser::sqf> parser, std::filesystem::path directory, size_t minimum_size) :
+    m_parser(std::move(parser)),
+    m_directory(std::move(directory)),
+    m_minimum_size(minimum_size)
+{
+    std::error_code err;
+    std::filesystem::create_directories(m_directory, err);
+}
+
+std::string sqf::parser::sqf::precompiled::fingerprint(::sqf::runtime::runtime& runtime) const
+{
+    std::stringstream sstream;
+    sstream << SQFVM_RUNTIME_VERSION << '-' << g_GIT_SHA1
+        << '-' << runtime.sqfop_nular_all().size()
+        << '-' << runtime.sqfop_unary_all().size()
+        << '-' << runtime.sqfop_binary_all().size()
+        << '-' << (runtime.configuration().enable_optimizer ? "O" : "")
+        << '-' << sizeof(::sqf::runtime::scalar_t);
+    return sstream.str();
+}
+
+std::filesystem::path sqf::parser::sqf::precompiled::file_of(std::string_view contents, const ::sqf::runtime::fileio::pathinfo& file) const
+{
+    std::stringstream sstream;
+    sstream << std::hex << std::setw(16) << std::setfill('0') << (fnv1a(contents) ^ fnv1a(file.physical + '\0' + file.virtual_)) << ".sqfc";
+    return m_directory / sstream.str();
+}
+
+bool sqf::parser::sqf::precompiled::check_syntax(::sqf::runtime::runtime& runtime, std::string contents, ::sqf::runtime::fileio::pathinfo file)
+{
+    return m_parser->check_syntax(runtime, std::move(contents), std::move(file));
+}
+
+std::optional<::sqf::runtime::instruction_set> sqf::parser::sqf::precompiled::parse(::sqf::runtime::runtime& runtime, std::string contents, ::sqf::runtime::fileio::pathinfo file)
+{
+    if (contents.size() < m_minimum_size)
+    {
+        return m_parser->parse(runtime, std::move(contents), std::move(file));
+    }
+    auto cache_path = file_of(contents, file);
+    auto print = fingerprint(runtime);
+    auto key = file.physical + '\0' + file.additional + '\0' + file.virtual_;
+
+    std::ifstream in(cache_path, std::ios::binary);
+    if (in.good())
+    {
+        std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        reader r(data);
+        auto valid = r.raw() == magic
+            && r.raw() == print
+            && r.raw() == key
+            && r.integer<uint64_t>() == fnv1a(contents)
+            && r.integer<uint64_t>() == contents.size()
+            && r.good();
+        if (valid)
+        {
+            auto set = deserialize(r.raw());
+            if (set.has_value())
+            {
+                return set;
+            }
+        }
+    }
+
+    auto set = m_parser->parse(runtime, contents, file);
+    if (!set.has_value())
+    {
+        return set;
+    }
+    auto blob = serialize(*set);
+    if (!blob.has_value())
+    {
+        return set;
+    }
+    writer w;
+    w.raw(magic);
+    w.raw(print);
+    w.raw(key);
+    w.integer(fnv1a(contents));
+    w.integer((uint64_t)contents.size());
+    w.raw(*blob);
+
+    // Written to a temporary file first, so concurrent runs (and threads) never observe partially written cache files.
+    auto temp_path = cache_path;
+    temp_path += "." + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count())
+        + "-" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    {
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+        if (!out.good())
+        {
+            return set;
+        }
+        out.write(w.str().data(), w.str().size());
+    }
+    std::error_code err;
+    std::filesystem::rename(temp_path, cache_path, err);
+    if (err)
+    {
+        std::filesystem::remove(temp_path, err);
+    }
+    return set;
+}
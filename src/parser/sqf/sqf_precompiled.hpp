@@ -0,0 +1,60 @@
+#pragma once
+#include "../../runtime/parser/sqf.h"
+#include "../../runtime/instruction_set.h"
+#include "../../runtime/fileio.h"
+
+#include <string>
+#include <string_view>
+#include <optional>
+#include <memory>
+#include <filesystem>
+
+namespace sqf::runtime
+{
+    class runtime;
+}
+namespace sqf::parser::sqf
+{
+    /// <summary>
+    /// Serializes the provided instruction_set, including the diag_info of every instruction,
+    /// into a binary blob that can be restored using deserialize.
+    /// </summary>
+    /// <returns>The blob or an empty optional if the set contains instructions or values that cannot be serialized.</returns>
+    std::optional<std::string> serialize(const ::sqf::runtime::instruction_set& set);
+
+    /// <summary>
+    /// Restores an instruction_set from a blob created by serialize.
+    /// </summary>
+    /// <returns>The instruction_set or an empty optional if the blob is truncated, corrupted or malformed.</returns>
+    std::optional<::sqf::runtime::instruction_set> deserialize(std::string_view blob);
+
+    /// <summary>
+    /// SQF parser that persists its results in a directory, allowing subsequent runs
+    /// to load precompiled instruction sets instead of parsing the same contents again.
+    /// Parsing itself is delegated to the wrapped parser.
+    /// </summary>
+    /// <remarks>
+    /// A cache file is only used if the contents, the file they originate from, the VM version,
+    /// the registered operators, the optimizer setting and the scalar width match the run that created it.
+    /// As the contents passed in are preprocessed already, changed defines or includes
+    /// invalidate the cache file too.
+    /// </remarks>
+    class precompiled : public ::sqf::runtime::parser::sqf
+    {
+    private:
+        std::unique_ptr<::sqf::runtime::parser::sqf> m_parser;
+        std::filesystem::path m_directory;
+        size_t m_minimum_size;
+
+        std::string fingerprint(::sqf::runtime::runtime& runtime) const;
+        std::filesystem::path file_of(std::string_view contents, const ::sqf::runtime::fileio::pathinfo& file) const;
+    public:
+        /// <param name="parser">The parser to use if no cache file is available.</param>
+        /// <param name="directory">The directory cache files are stored in. Created if it does not exist.</param>
+        /// <param name="minimum_size">Contents smaller than this are always parsed directly.</param>
+        precompiled(std::unique_ptr<::sqf::runtime::parser::sqf> parser, std::filesystem::path directory, size_t minimum_size = 512);
+        virtual ~precompiled() override { };
+        virtual bool check_syntax(::sqf::runtime::runtime& runtime, std::string contents, ::sqf::runtime::fileio::pathinfo file) override;
+        virtual std::optional<::sqf::runtime::instruction_set> parse(::sqf::runtime::runtime& runtime, std::string contents, ::sqf::runtime::fileio::pathinfo file) override;
+    };
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include "value.h"
+
+#include <vector>
+#include <cstdint>
+
+namespace sqf::runtime
+{
+    /// <summary>
+    /// Compact, contiguous form of an instruction_set that the runtime dispatches with a switch.
+    /// Every op corresponds to the instruction at the same position of the instruction_set,
+    /// instructions without a dedicated opcode are dispatched through the instruction itself.
+    /// </summary>
+    class bytecode
+    {
+    public:
+        enum class opcode : uint8_t
+        {
+            /// <summary>
+            /// Dispatches to sqf::runtime::instruction::execute.
+            /// </summary>
+            instruction,
+            /// <summary>
+            /// Pushes the constant at operand onto the value stack.
+            /// </summary>
+            push,
+            /// <summary>
+            /// Clears the value stack of the current frame.
+            /// </summary>
+            end_statement
+        };
+        struct op
+        {
+            opcode code;
+            uint32_t operand;
+        };
+    private:
+        std::vector<op> m_ops;
+        std::vector<sqf::runtime::value> m_constants;
+    public:
+        bytecode() = default;
+
+        void emit_instruction() { m_ops.push_back({ opcode::instruction, 0 }); }
+        void emit_push(sqf::runtime::value val)
+        {
+            m_ops.push_back({ opcode::push, (uint32_t)m_constants.size() });
+            m_constants.push_back(std::move(val));
+        }
+        void emit_end_statement() { m_ops.push_back({ opcode::end_statement, 0 }); }
+
+        size_t size() const { return m_ops.size(); }
+        const op& operator[](size_t index) const { return m_ops[index]; }
+        sqf::runtime::value::cref constant(uint32_t index) const { return m_constants[index]; }
+    };
+}
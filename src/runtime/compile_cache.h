@@ -0,0 +1,153 @@
+#pragma once
+#include "instruction_set.h"
+#include "fileio.h"
+
+#include <list>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <functional>
+#include <unordered_map>
+
+namespace sqf::runtime
+{
+    /// <summary>
+    /// Maps SQF source text to the instruction_set it was parsed into,
+    /// so that repeated compilation of the same text can skip the parser.
+    /// Entries are keyed by the hash of contents, path and whether the optimizer ran, and get evicted
+    /// least-recently-used first once the capacity is exceeded.
+    /// </summary>
+    class compile_cache
+    {
+    private:
+        struct entry
+        {
+            size_t hash;
+            std::string path;
+            std::string contents;
+            bool optimized;
+            sqf::runtime::instruction_set set;
+
+            /// <summary>
+            /// Approximation of the memory occupied by this entry.
+            /// </summary>
+            size_t bytes() const
+            {
+                return sizeof(entry) + path.size() + contents.size() + set.size() * instruction_bytes;
+            }
+        };
+        // Rough size of a single instruction including its control block.
+        static const size_t instruction_bytes = 96;
+
+        std::list<entry> m_entries;
+        std::unordered_multimap<size_t, std::list<entry>::iterator> m_index;
+        size_t m_capacity;
+        size_t m_bytes;
+        size_t m_hits;
+        size_t m_misses;
+        size_t m_evictions;
+
+        static std::string path_of(const sqf::runtime::fileio::pathinfo& file)
+        {
+            std::string path;
+            path.reserve(file.physical.size() + file.additional.size() + file.virtual_.size() + 2);
+            path.append(file.physical);
+            path.push_back('\0');
+            path.append(file.additional);
+            path.push_back('\0');
+            path.append(file.virtual_);
+            return path;
+        }
+        static size_t hash_of(std::string_view path, std::string_view contents, bool optimized)
+        {
+            auto hash = std::hash<std::string_view>{}(contents) + (optimized ? 1 : 0);
+            return hash ^ (std::hash<std::string_view>{}(path) + 0x9e3779b9 + (hash << 6) + (hash >> 2));
+        }
+
+        void evict()
+        {
+            while (m_bytes > m_capacity && !m_entries.empty())
+            {
+                auto it = std::prev(m_entries.end());
+                auto range = m_index.equal_range(it->hash);
+                for (auto index = range.first; index != range.second; ++index)
+                {
+                    if (index->second == it)
+                    {
+                        m_index.erase(index);
+                        break;
+                    }
+                }
+                m_bytes -= it->bytes();
+                m_entries.erase(it);
+                m_evictions++;
+            }
+        }
+    public:
+        compile_cache(size_t capacity) : m_capacity(capacity), m_bytes(0), m_hits(0), m_misses(0), m_evictions(0) {}
+
+        /// <summary>
+        /// Receives the instruction_set previously stored for the provided contents and file,
+        /// parsed with the optimizer enabled or disabled as requested.
+        /// Counts as hit or miss.
+        /// </summary>
+        std::optional<sqf::runtime::instruction_set> find(std::string_view contents, const sqf::runtime::fileio::pathinfo& file, bool optimized)
+        {
+            auto path = path_of(file);
+            auto range = m_index.equal_range(hash_of(path, contents, optimized));
+            for (auto index = range.first; index != range.second; ++index)
+            {
+                auto it = index->second;
+                if (it->optimized == optimized && it->contents == contents && it->path == path)
+                {
+                    m_entries.splice(m_entries.begin(), m_entries, it);
+                    m_hits++;
+                    return it->set;
+                }
+            }
+            m_misses++;
+            return {};
+        }
+
+        /// <summary>
+        /// Stores the instruction_set parsed from the provided contents and file with the optimizer enabled or disabled,
+        /// evicting the least recently used entries if the capacity got exceeded.
+        /// </summary>
+        void insert(std::string contents, const sqf::runtime::fileio::pathinfo& file, bool optimized, sqf::runtime::instruction_set set)
+        {
+            if (m_capacity == 0)
+            {
+                return;
+            }
+            auto path = path_of(file);
+            auto hash = hash_of(path, contents, optimized);
+            m_entries.push_front({ hash, std::move(path), std::move(contents), optimized, std::move(set) });
+            m_index.emplace(hash, m_entries.begin());
+            m_bytes += m_entries.front().bytes();
+            evict();
+        }
+
+        /// <summary>
+        /// Removes all entries. Required whenever the parse result of some contents may change,
+        /// eg. due to operators getting registered.
+        /// </summary>
+        void clear()
+        {
+            m_index.clear();
+            m_entries.clear();
+            m_bytes = 0;
+        }
+
+        /// <summary>
+        /// Sets the maximum amount of bytes (approximated) the cache may occupy.
+        /// A capacity of 0 disables the cache.
+        /// </summary>
+        void capacity(size_t bytes) { m_capacity = bytes; evict(); }
+        size_t capacity() const { return m_capacity; }
+        size_t bytes() const { return m_bytes; }
+        size_t size() const { return m_entries.size(); }
+        size_t hits() const { return m_hits; }
+        size_t misses() const { return m_misses; }
+        size_t evictions() const { return m_evictions; }
+    };
+}
@@ -28,13 +28,35 @@ namespace sqf::runtime
         std::chrono::system_clock::time_point m_wakeup_timestamp;
         std::string m_name;
         bool m_terminate;
+        size_t m_instruction_budget;
+        size_t m_instructions_left;
+        // Context whose variables get searched once lookups bubbled through all own frames.
+        const context* m_variables_fallback;
+
+        sqf::runtime::frame& frame_pushed()
+        {
+            m_frames.back().value_stack_pos(m_values.size());
+#ifdef DF__SQF_RUNTIME__ASSEMBLY_DEBUG_ON_EXECUTE
+
+            std::cout << "\x1B[33m[ASSEMBLY ASSERT]\033[0m" <<
+                "[FC:" << std::setw(3) << frames_size() << "]" <<
+                "[VC:" << std::setw(3) << values_size() << "]" <<
+                "    " << "    " << "Pushed \x1B[91mFrame\033[0m ";
+            m_frames.back().dbg_str();
+            std::cout << std::endl;
+#endif // DF__SQF_RUNTIME__ASSEMBLY_DEBUG_ON_EXECUTE
+            return m_frames.back();
+        }
 
     public:
         context() :
             m_can_suspend(false),
             m_suspended(false),
             m_weak_error_handling(false),
-            m_terminate(false)
+            m_terminate(false),
+            m_instruction_budget(0),
+            m_instructions_left(~(size_t)0),
+            m_variables_fallback(nullptr)
         { }
 
 
@@ -70,36 +92,40 @@ namespace sqf::runtime
                 }
             }
         }
-        void push_frame(sqf::runtime::frame frame)
+        /// <summary>
+        /// Pushes the provided frame onto the frame stack, taking ownership of it.
+        /// </summary>
+        /// <returns>The frame on the stack. Only valid until the frame stack is modified again.</returns>
+        sqf::runtime::frame& push_frame(sqf::runtime::frame frame)
         {
-            m_frames.push_back(frame);
-            m_frames.back().value_stack_pos(m_values.size());
-#ifdef DF__SQF_RUNTIME__ASSEMBLY_DEBUG_ON_EXECUTE
-
-            std::cout << "\x1B[33m[ASSEMBLY ASSERT]\033[0m" <<
-                "[FC:" << std::setw(3) << frames_size() << "]" <<
-                "[VC:" << std::setw(3) << values_size() << "]" <<
-                "    " << "    " << "Pushed \x1B[91mFrame\033[0m ";
-            m_frames.back().dbg_str();
-            std::cout << std::endl;
-#endif // DF__SQF_RUNTIME__ASSEMBLY_DEBUG_ON_EXECUTE
+            m_frames.push_back(std::move(frame));
+            return frame_pushed();
+        }
+        /// <summary>
+        /// Constructs a frame in place on top of the frame stack.
+        /// </summary>
+        /// <returns>The frame on the stack. Only valid until the frame stack is modified again.</returns>
+        template<class... TArgs>
+        sqf::runtime::frame& emplace_frame(TArgs&&... args)
+        {
+            m_frames.emplace_back(std::forward<TArgs>(args)...);
+            return frame_pushed();
         }
         void push_value(sqf::runtime::value value)
         {
-            m_values.push_back(value);
+            m_values.push_back(std::move(value));
 
 #ifdef DF__SQF_RUNTIME__ASSEMBLY_DEBUG_ON_EXECUTE
 
             std::cout << "\x1B[33m[ASSEMBLY ASSERT]\033[0m" <<
                 "[FC:" << std::setw(3) << frames_size() << "]" <<
                 "[VC:" << std::setw(3) << values_size() << "]" <<
-                "    " << "    " << "Pushed Return \x1B[92mValue\033[0m " << value.to_string_sqf() << std::endl;
+                "    " << "    " << "Pushed Return \x1B[92mValue\033[0m " << m_values.back().to_string_sqf() << std::endl;
 
 #endif // DF__SQF_RUNTIME__ASSEMBLY_DEBUG_ON_EXECUTE
         }
-        sqf::runtime::frame&& pop_frame()
+        void pop_frame()
         {
-            auto& frame = m_frames.back();
             m_frames.pop_back();
 #ifdef DF__SQF_RUNTIME__ASSEMBLY_DEBUG_ON_EXECUTE
 
@@ -109,7 +135,6 @@ namespace sqf::runtime
                 "    " << "    " << "Popped \x1B[91mFrame\033[0m" << std::endl;
 
 #endif // DF__SQF_RUNTIME__ASSEMBLY_DEBUG_ON_EXECUTE
-            return std::move(frame);
         }
         std::optional<sqf::runtime::value> pop_value(bool ingore_frame_boundaries = false)
         {
@@ -119,7 +144,7 @@ namespace sqf::runtime
             }
             else
             {
-                auto value = m_values.back();
+                auto value = std::move(m_values.back());
                 m_values.pop_back();
 #ifdef DF__SQF_RUNTIME__ASSEMBLY_DEBUG_ON_EXECUTE
 
@@ -141,22 +166,33 @@ namespace sqf::runtime
         std::vector<sqf::runtime::value>::reverse_iterator values_rbegin() { return m_values.rbegin(); }
         std::vector<sqf::runtime::value>::reverse_iterator values_rend() { return m_values.rend(); }
 
-        std::optional<sqf::runtime::value> get_variable(std::string variable_name) const
+        std::optional<sqf::runtime::value> get_variable(const sqf::runtime::symbol& variable) const
         {
-            std::transform(variable_name.begin(), variable_name.end(), variable_name.begin(), [](char& c) { return (char)std::tolower((int)c); });
             for (auto rit = m_frames.rbegin(); rit != m_frames.rend(); rit++)
             {
-                if (rit->contains(variable_name))
+                if (auto res = rit->find(variable))
                 {
-                    return (*rit)[variable_name];
+                    return *res;
                 }
                 else if (!rit->bubble_variable())
                 {
                     return {};
                 }
             }
+            if (m_variables_fallback)
+            {
+                return m_variables_fallback->get_variable(variable);
+            }
             return {};
         }
+        std::optional<sqf::runtime::value> get_variable(std::string_view variable_name) const { return get_variable(sqf::runtime::symbol::transient(variable_name)); }
+
+        /// <summary>
+        /// Makes the variables of the provided context readable from this one, as if its frames were placed below the own frames.
+        /// They are looked up in place, never copied. Assignments still only end up in the own frames.
+        /// The provided context has to outlive its use as fallback. Pass nullptr to remove it again.
+        /// </summary>
+        void variables_fallback(const context* fallback) { m_variables_fallback = fallback; }
 
         bool weak_error_handling() const { return m_weak_error_handling; }
         void weak_error_handling(bool flag) { m_weak_error_handling = flag; }
@@ -165,5 +201,15 @@ namespace sqf::runtime
 
         bool terminate() const { return m_terminate; }
         void terminate(bool flag) { m_terminate = flag; }
+
+        /// <summary>
+        /// Limits the amount of instructions this context may execute, counting from now on.
+        /// Disables the limit if 0.
+        /// </summary>
+        void instruction_budget(size_t budget) { m_instruction_budget = budget; m_instructions_left = budget == 0 ? ~(size_t)0 : budget; }
+        size_t instruction_budget() const { return m_instruction_budget; }
+
+        bool instruction_budget_exhausted() const { return m_instructions_left == 0; }
+        void instruction_budget_consume() { m_instructions_left--; }
     };
 }
@@ -3,11 +3,13 @@
 #include "data.h"
 #include "type.h"
 #include "value.h"
+#include "pool_allocator.h"
 #include "d_scalar.h"
 
 #include <string>
 #include <memory>
 #include <vector>
+#include <unordered_set>
 #include <algorithm>
 #include <sstream>
 #include <array>
@@ -78,7 +80,7 @@ namespace sqf
                         return false;
                     }
                     // Do actual comparison
-                    else if (!m_value[i].data()->equals(other_array->m_value[i].data(), invariant))
+                    else if (!m_value[i].equals(other_array->m_value[i], invariant))
                     {
                         return false;
                     }
@@ -103,10 +105,10 @@ namespace sqf
                     }
                     else
                     {
-                        copy.emplace_back(val.data());
+                        copy.emplace_back(val);
                     }
                 }
-                return std::make_shared<d_array>(copy);
+                return sqf::runtime::make_pooled<d_array>(copy);
             }
 
             std::string to_string_sqf() const override
@@ -144,6 +146,42 @@ namespace sqf
             // Returns false, if current array state contains a recursion.
             bool recursion_test() { std::vector<std::shared_ptr<d_array>> vec; return recursion_test_(vec); }
 
+            // Returns true, if target is this array or nested somewhere inside of it.
+            bool reaches(const d_array* target) const
+            {
+                std::vector<const d_array*> pending = { this };
+                std::unordered_set<const d_array*> visited = { this };
+                while (!pending.empty())
+                {
+                    auto current = pending.back();
+                    pending.pop_back();
+                    if (current == target)
+                    {
+                        return true;
+                    }
+                    for (auto& it : current->m_value)
+                    {
+                        if (it.is<sqf::runtime::t_array>())
+                        {
+                            auto child = it.data<d_array>().get();
+                            if (visited.insert(child).second)
+                            {
+                                pending.push_back(child);
+                            }
+                        }
+                    }
+                }
+                return false;
+            }
+
+            // Returns true, if storing the provided value inside of this array would create a recursion.
+            // Only arrays that contain this array (or are this array) may do so, hence
+            // checking a value that is no array is constant time.
+            bool would_recurse(const sqf::runtime::value& val) const
+            {
+                return val.is<sqf::runtime::t_array>() && val.data<d_array>()->reaches(this);
+            }
+
 
 
             sqf::runtime::value& operator[](size_t index) { return at(index); }
@@ -165,7 +203,7 @@ namespace sqf
             iterator insert(iterator start, TIterator begin, TIterator end) { return m_value.insert(start, begin, end); }
 
             //#TODO emplace back
-            bool push_back(sqf::runtime::value val) { m_value.push_back(std::move(val)); if (!recursion_test()) { m_value.pop_back(); return false; } return true; }
+            bool push_back(sqf::runtime::value val) { if (would_recurse(val)) { return false; } m_value.push_back(std::move(val)); return true; }
             sqf::runtime::value pop_back() { auto back = m_value.back(); m_value.pop_back(); return back; }
 
             void reverse() { std::reverse(m_value.begin(), m_value.end()); }
@@ -203,9 +241,9 @@ namespace sqf
             operator sqf::runtime::vec3()
             {
                 sqf::runtime::vec3 v;
-                if (size() > 0) { v.x = at(0).data_try<d_scalar, float>(0); }
-                if (size() > 1) { v.y = at(1).data_try<d_scalar, float>(0); }
-                if (size() > 2) { v.z = at(2).data_try<d_scalar, float>(0); }
+                if (size() > 0) { v.x = at(0).data_try<d_scalar, ::sqf::runtime::scalar_t>(0); }
+                if (size() > 1) { v.y = at(1).data_try<d_scalar, ::sqf::runtime::scalar_t>(0); }
+                if (size() > 2) { v.z = at(2).data_try<d_scalar, ::sqf::runtime::scalar_t>(0); }
                 return v;
             }
 
@@ -223,42 +261,42 @@ namespace sqf
         template<>
         inline std::shared_ptr<sqf::runtime::data> to_data<std::vector<sqf::runtime::value>>(std::vector<sqf::runtime::value> arr)
         {
-            return std::make_shared<d_array>(arr);
+            return sqf::runtime::make_pooled<d_array>(arr);
         }
 
-        float distance3dsqr(const std::shared_ptr<sqf::types::d_array>& l, const std::shared_ptr<sqf::types::d_array>& r);
-        float distance3dsqr(const d_array* l, const d_array* r);
-        inline float distance3dsqr(const ::sqf::runtime::vec3 l, const ::sqf::runtime::vec3 r)
-        { return (float)(std::pow(l.x - r.x, 2) + std::pow(l.y - r.y, 2) + std::pow(l.z - r.z, 2)); }
-        inline float distance3dsqr(std::array<float, 3> l, std::array<float, 3> r)
-        { return (float)(std::pow(l[0] - r[0], 2) + std::pow(l[1] - r[1], 2) + std::pow(l[2] - r[2], 2)); }
+        ::sqf::runtime::scalar_t distance3dsqr(const std::shared_ptr<sqf::types::d_array>& l, const std::shared_ptr<sqf::types::d_array>& r);
+        ::sqf::runtime::scalar_t distance3dsqr(const d_array* l, const d_array* r);
+        inline ::sqf::runtime::scalar_t distance3dsqr(const ::sqf::runtime::vec3 l, const ::sqf::runtime::vec3 r)
+        { return (::sqf::runtime::scalar_t)(std::pow(l.x - r.x, 2) + std::pow(l.y - r.y, 2) + std::pow(l.z - r.z, 2)); }
+        inline ::sqf::runtime::scalar_t distance3dsqr(std::array<::sqf::runtime::scalar_t, 3> l, std::array<::sqf::runtime::scalar_t, 3> r)
+        { return (::sqf::runtime::scalar_t)(std::pow(l[0] - r[0], 2) + std::pow(l[1] - r[1], 2) + std::pow(l[2] - r[2], 2)); }
 
-        float distance3d(const std::shared_ptr<d_array>& l, const std::shared_ptr<d_array>& r);
-        float distance3d(const d_array* l, const d_array* r);
-        inline float distance3d(const ::sqf::runtime::vec3 l, const ::sqf::runtime::vec3 r)
+        ::sqf::runtime::scalar_t distance3d(const std::shared_ptr<d_array>& l, const std::shared_ptr<d_array>& r);
+        ::sqf::runtime::scalar_t distance3d(const d_array* l, const d_array* r);
+        inline ::sqf::runtime::scalar_t distance3d(const ::sqf::runtime::vec3 l, const ::sqf::runtime::vec3 r)
         { return std::sqrt(distance3dsqr(l, r)); }
-        inline float distance3d(std::array<float, 3> l, std::array<float, 3> r)
+        inline ::sqf::runtime::scalar_t distance3d(std::array<::sqf::runtime::scalar_t, 3> l, std::array<::sqf::runtime::scalar_t, 3> r)
         { return std::sqrt(distance3dsqr(l, r)); }
 
-        float distance2dsqr(const std::shared_ptr<d_array>& l, const std::shared_ptr<d_array>& r);
-        float distance2dsqr(const d_array* l, const d_array* r);
-        inline float distance2dsqr(const ::sqf::runtime::vec3 l, const ::sqf::runtime::vec3 r) 
-        { return (float)(std::pow(l.x - r.x, 2) + std::pow(l.y - r.y, 2)); }
-        inline float distance2dsqr(std::array<float, 2> l, std::array<float, 2> r)
-        { return (float)(std::pow(l[0] - r[0], 2) + std::pow(l[1] - r[1], 2)); }
+        ::sqf::runtime::scalar_t distance2dsqr(const std::shared_ptr<d_array>& l, const std::shared_ptr<d_array>& r);
+        ::sqf::runtime::scalar_t distance2dsqr(const d_array* l, const d_array* r);
+        inline ::sqf::runtime::scalar_t distance2dsqr(const ::sqf::runtime::vec3 l, const ::sqf::runtime::vec3 r) 
+        { return (::sqf::runtime::scalar_t)(std::pow(l.x - r.x, 2) + std::pow(l.y - r.y, 2)); }
+        inline ::sqf::runtime::scalar_t distance2dsqr(std::array<::sqf::runtime::scalar_t, 2> l, std::array<::sqf::runtime::scalar_t, 2> r)
+        { return (::sqf::runtime::scalar_t)(std::pow(l[0] - r[0], 2) + std::pow(l[1] - r[1], 2)); }
 
-        float distance2d(const std::shared_ptr<d_array>& l, const std::shared_ptr<d_array>& r);
-        float distance2d(const d_array* l, const d_array* r);
-        inline float distance2d(const ::sqf::runtime::vec3 l, const ::sqf::runtime::vec3 r)
+        ::sqf::runtime::scalar_t distance2d(const std::shared_ptr<d_array>& l, const std::shared_ptr<d_array>& r);
+        ::sqf::runtime::scalar_t distance2d(const d_array* l, const d_array* r);
+        inline ::sqf::runtime::scalar_t distance2d(const ::sqf::runtime::vec3 l, const ::sqf::runtime::vec3 r)
         { return std::sqrt(distance2dsqr(l, r)); }
-        inline float distance2d(std::array<float, 2> l, std::array<float, 2> r)
+        inline ::sqf::runtime::scalar_t distance2d(std::array<::sqf::runtime::scalar_t, 2> l, std::array<::sqf::runtime::scalar_t, 2> r)
         { return std::sqrt(distance2dsqr(l, r)); }
 
 
 
 #define SQF_RUNTIME_D_ARRAY_EXPANDO_TO_DATA_HELPER(SIZE)\
             template<>inline std::shared_ptr<sqf::runtime::data>to_data<std::array<sqf::runtime::value,SIZE>>(std::array<sqf::runtime::value,SIZE>arr)\
-            {return std::make_shared<d_array>(arr.begin(),arr.end());}
+            {return sqf::runtime::make_pooled<d_array>(arr.begin(),arr.end());}
 #define SQF_RUNTIME_D_ARRAY_EXPANDO_TO_DATA_HELPER_10(SIZEX10)\
             SQF_RUNTIME_D_ARRAY_EXPANDO_TO_DATA_HELPER((SIZEX10) + 0)\
             SQF_RUNTIME_D_ARRAY_EXPANDO_TO_DATA_HELPER((SIZEX10) + 1)\
@@ -2,6 +2,7 @@
 #include "data.h"
 #include "type.h"
 #include "value.h"
+#include "pool_allocator.h"
 
 
 #include <string>
@@ -9,10 +10,6 @@
 
 namespace sqf
 {
-    namespace runtime
-    {
-        struct t_boolean : public type::extend<t_boolean> { t_boolean() : extend() {} static const std::string name() { return "BOOL"; } };
-    }
     namespace types
     {
         class d_boolean : public sqf::runtime::data
@@ -53,7 +50,7 @@ namespace sqf
         template<>
         inline std::shared_ptr<sqf::runtime::data> to_data<bool>(bool flag)
         {
-            return std::make_shared<d_boolean>(flag);
+            return sqf::runtime::make_pooled<d_boolean>(flag);
         }
     }
 }
\ No newline at end of file
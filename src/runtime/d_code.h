@@ -8,6 +8,7 @@
 #include <memory>
 #include <algorithm>
 #include <sstream>
+#include <optional>
 
 
 namespace sqf
@@ -24,11 +25,21 @@ namespace sqf
             using data_type = sqf::runtime::t_code;
         private:
             sqf::runtime::instruction_set m_value;
+            // Structural hash of m_value, created on first use.
+            mutable std::optional<std::size_t> m_hash;
 
         protected:
             bool do_equals(std::shared_ptr<data> other, bool invariant) const override
             {
                 auto casted = std::static_pointer_cast<d_code>(other);
+                if (m_value.shares_instructions(casted->m_value))
+                {
+                    return true;
+                }
+                if (hash() != casted->hash())
+                {
+                    return false;
+                }
                 return std::equal(m_value.begin(), m_value.end(), casted->m_value.begin(), casted->m_value.end(),
                     [](::sqf::runtime::instruction::sptr left, ::sqf::runtime::instruction::sptr right) { return left->equals(right.get()); });
             }
@@ -88,10 +99,22 @@ namespace sqf
             }
 
             sqf::runtime::type type() const override { return data_type(); }
-            virtual std::size_t hash() const override { return std::hash<std::string>()(to_string_sqf()); }
+            virtual std::size_t hash() const override
+            {
+                if (!m_hash.has_value())
+                {
+                    size_t hash = 0x9e3779b9;
+                    for (auto& it : m_value)
+                    {
+                        hash = sqf::runtime::instruction::hash_combine(hash, it->hash());
+                    }
+                    m_hash = hash;
+                }
+                return *m_hash;
+            }
 
             const sqf::runtime::instruction_set& value() const { return m_value; }
-            void value(sqf::runtime::instruction_set flag) { m_value = flag; }
+            void value(sqf::runtime::instruction_set flag) { m_value = flag; m_hash.reset(); }
 
             operator const sqf::runtime::instruction_set&() const { return m_value; }
             operator sqf::runtime::instruction_set&() { return m_value; }
@@ -2,23 +2,30 @@
 #include <sstream>
 #include <iomanip>
 
+#ifdef DF__SQF_RUNTIME__SCALAR_DOUBLE
+// Enough significant digits to print large integers and accumulated sums without rounding them away.
+static constexpr const char general_format[] = "%.15g";
+#else
+static constexpr const char general_format[] = "%g";
+#endif // DF__SQF_RUNTIME__SCALAR_DOUBLE
 
 std::string sqf::types::d_scalar::to_string_sqf() const
 {
-    if (s_decimals == -1)
+    auto decimals = s_decimals ? *s_decimals : -1;
+    if (decimals == -1)
     {
-        auto bufflen = std::snprintf(nullptr, 0, "%g", m_value) + 1;
+        auto bufflen = std::snprintf(nullptr, 0, general_format, m_value) + 1;
         auto buff = new char[bufflen];
-        std::snprintf(buff, bufflen, "%g", m_value);
+        std::snprintf(buff, bufflen, general_format, m_value);
         auto str = std::string(buff, bufflen - 1);
         delete[] buff;
         return str;
     }
     else
     {
-        auto bufflen = std::snprintf(nullptr, 0, "%0.*f", s_decimals, m_value) + 1;
+        auto bufflen = std::snprintf(nullptr, 0, "%0.*f", decimals, m_value) + 1;
         auto buff = new char[bufflen];
-        std::snprintf(buff, bufflen, "%0.*f", s_decimals, m_value);
+        std::snprintf(buff, bufflen, "%0.*f", decimals, m_value);
         auto str = std::string(buff, bufflen - 1);
         delete[] buff;
         return str;
@@ -27,20 +34,21 @@ std::string sqf::types::d_scalar::to_string_sqf() const
 
 std::string sqf::types::d_scalar::to_string() const
 {
-    if (s_decimals == -1)
+    auto decimals = s_decimals ? *s_decimals : -1;
+    if (decimals == -1)
     {
-        auto bufflen = std::snprintf(nullptr, 0, "%g", m_value) + 1;
+        auto bufflen = std::snprintf(nullptr, 0, general_format, m_value) + 1;
         auto buff = new char[bufflen];
-        std::snprintf(buff, bufflen, "%g", m_value);
+        std::snprintf(buff, bufflen, general_format, m_value);
         auto str = std::string(buff, bufflen - 1);
         delete[] buff;
         return str;
     }
     else
     {
-        auto bufflen = std::snprintf(nullptr, 0, "%0.*f", s_decimals, m_value) + 1;
+        auto bufflen = std::snprintf(nullptr, 0, "%0.*f", decimals, m_value) + 1;
         auto buff = new char[bufflen];
-        std::snprintf(buff, bufflen, "%0.*f", s_decimals, m_value);
+        std::snprintf(buff, bufflen, "%0.*f", decimals, m_value);
         auto str = std::string(buff, bufflen - 1);
         delete[] buff;
         return str;
@@ -5,14 +5,11 @@
 #include "data.h"
 #include "type.h"
 #include "value.h"
+#include "pool_allocator.h"
 
 
 namespace sqf
 {
-    namespace runtime
-    {
-        struct t_scalar : public type::extend<t_scalar> { t_scalar() : extend() {} static const std::string name() { return "SCALAR"; } };
-    }
     namespace types
     {
         class d_scalar : public sqf::runtime::data
@@ -20,8 +17,9 @@ namespace sqf
         public:
             using data_type = sqf::runtime::t_scalar;
         private:
-            float m_value;
-            inline static int s_decimals = -1;
+            sqf::runtime::scalar_t m_value;
+            // Decimals of the runtime formatting on this thread, see decimals_scope.
+            inline static thread_local const int* s_decimals = nullptr;
         protected:
             bool do_equals(std::shared_ptr<data> other, bool invariant) const override
             {
@@ -29,46 +27,59 @@ namespace sqf
             }
         public:
             d_scalar() = default;
-            d_scalar(int8_t  value)       : m_value((float)value) {}
-            d_scalar(int16_t value)       : m_value((float)value) {}
-            d_scalar(int32_t value)       : m_value((float)value) {}
-            d_scalar(int64_t value)       : m_value((float)value) {}
-            d_scalar(uint8_t  value)      : m_value((float)value) {}
-            d_scalar(uint16_t value)      : m_value((float)value) {}
-            d_scalar(uint32_t value)      : m_value((float)value) {}
-            d_scalar(uint64_t value)      : m_value((float)value) {}
+            d_scalar(int8_t  value)       : m_value((sqf::runtime::scalar_t)value) {}
+            d_scalar(int16_t value)       : m_value((sqf::runtime::scalar_t)value) {}
+            d_scalar(int32_t value)       : m_value((sqf::runtime::scalar_t)value) {}
+            d_scalar(int64_t value)       : m_value((sqf::runtime::scalar_t)value) {}
+            d_scalar(uint8_t  value)      : m_value((sqf::runtime::scalar_t)value) {}
+            d_scalar(uint16_t value)      : m_value((sqf::runtime::scalar_t)value) {}
+            d_scalar(uint32_t value)      : m_value((sqf::runtime::scalar_t)value) {}
+            d_scalar(uint64_t value)      : m_value((sqf::runtime::scalar_t)value) {}
 #ifdef __APPLE__
-            d_scalar(long value) : m_value((float)value) {}
-            d_scalar(unsigned long value) : m_value((float)value) {}
+            d_scalar(long value) : m_value((sqf::runtime::scalar_t)value) {}
+            d_scalar(unsigned long value) : m_value((sqf::runtime::scalar_t)value) {}
 #endif //  __APPLE__
-            d_scalar(float value)         : m_value((float)value) {}
-            d_scalar(double value)        : m_value((float)value) {}
+            d_scalar(float value)         : m_value((sqf::runtime::scalar_t)value) {}
+            d_scalar(double value)        : m_value((sqf::runtime::scalar_t)value) {}
 
             std::string to_string_sqf() const override;
             std::string to_string() const override;
 
             sqf::runtime::type type() const override { return data_type(); }
-            virtual std::size_t hash() const override { return std::hash<float>()(m_value); }
-            float value() const { return m_value; }
-            void value(float f) { m_value = f; }
-            operator float() { return m_value; }
-            static void set_decimals(int val) { s_decimals = val; }
+            virtual std::size_t hash() const override { return std::hash<sqf::runtime::scalar_t>()(m_value); }
+            sqf::runtime::scalar_t value() const { return m_value; }
+            void value(sqf::runtime::scalar_t f) { m_value = f; }
+            operator sqf::runtime::scalar_t() { return m_value; }
+
+            /// <summary>
+            /// Makes SCALAR values formatted on the calling thread use the provided decimals
+            /// (-1 for the default format) until destroyed. The decimals are referenced, not copied.
+            /// </summary>
+            class decimals_scope
+            {
+                const int* m_previous;
+            public:
+                decimals_scope(const int& decimals) : m_previous(s_decimals) { s_decimals = &decimals; }
+                decimals_scope(const decimals_scope&) = delete;
+                decimals_scope& operator=(const decimals_scope&) = delete;
+                ~decimals_scope() { s_decimals = m_previous; }
+            };
         };
 
-        template<> inline std::shared_ptr<sqf::runtime::data> to_data<int8_t>(int8_t  value)              { return std::make_shared<d_scalar>(value); }
-        template<> inline std::shared_ptr<sqf::runtime::data> to_data<int16_t>(int16_t value)             { return std::make_shared<d_scalar>(value); }
-        template<> inline std::shared_ptr<sqf::runtime::data> to_data<int32_t>(int32_t value)             { return std::make_shared<d_scalar>(value); }
-        template<> inline std::shared_ptr<sqf::runtime::data> to_data<int64_t>(int64_t value)             { return std::make_shared<d_scalar>(value); }
-        template<> inline std::shared_ptr<sqf::runtime::data> to_data<uint8_t>(uint8_t  value)            { return std::make_shared<d_scalar>(value); }
-        template<> inline std::shared_ptr<sqf::runtime::data> to_data<uint16_t>(uint16_t value)           { return std::make_shared<d_scalar>(value); }
-        template<> inline std::shared_ptr<sqf::runtime::data> to_data<uint32_t>(uint32_t value)           { return std::make_shared<d_scalar>(value); }
-        template<> inline std::shared_ptr<sqf::runtime::data> to_data<uint64_t>(uint64_t value)           { return std::make_shared<d_scalar>(value); }
+        template<> inline std::shared_ptr<sqf::runtime::data> to_data<int8_t>(int8_t  value)              { return sqf::runtime::make_pooled<d_scalar>(value); }
+        template<> inline std::shared_ptr<sqf::runtime::data> to_data<int16_t>(int16_t value)             { return sqf::runtime::make_pooled<d_scalar>(value); }
+        template<> inline std::shared_ptr<sqf::runtime::data> to_data<int32_t>(int32_t value)             { return sqf::runtime::make_pooled<d_scalar>(value); }
+        template<> inline std::shared_ptr<sqf::runtime::data> to_data<int64_t>(int64_t value)             { return sqf::runtime::make_pooled<d_scalar>(value); }
+        template<> inline std::shared_ptr<sqf::runtime::data> to_data<uint8_t>(uint8_t  value)            { return sqf::runtime::make_pooled<d_scalar>(value); }
+        template<> inline std::shared_ptr<sqf::runtime::data> to_data<uint16_t>(uint16_t value)           { return sqf::runtime::make_pooled<d_scalar>(value); }
+        template<> inline std::shared_ptr<sqf::runtime::data> to_data<uint32_t>(uint32_t value)           { return sqf::runtime::make_pooled<d_scalar>(value); }
+        template<> inline std::shared_ptr<sqf::runtime::data> to_data<uint64_t>(uint64_t value)           { return sqf::runtime::make_pooled<d_scalar>(value); }
 #ifdef __APPLE__
-        template<> inline std::shared_ptr<sqf::runtime::data> to_data<long>(long value)                   { return std::make_shared<d_scalar>(value); }
-        template<> inline std::shared_ptr<sqf::runtime::data> to_data<unsigned long>(unsigned long value) { return std::make_shared<d_scalar>(value); }
+        template<> inline std::shared_ptr<sqf::runtime::data> to_data<long>(long value)                   { return sqf::runtime::make_pooled<d_scalar>(value); }
+        template<> inline std::shared_ptr<sqf::runtime::data> to_data<unsigned long>(unsigned long value) { return sqf::runtime::make_pooled<d_scalar>(value); }
 #endif //  __APPLE__
-        template<> inline std::shared_ptr<sqf::runtime::data> to_data<float>(float value)                 { return std::make_shared<d_scalar>(value); }
-        template<> inline std::shared_ptr<sqf::runtime::data> to_data<double>(double value)               { return std::make_shared<d_scalar>(value); }
+        template<> inline std::shared_ptr<sqf::runtime::data> to_data<float>(float value)                 { return sqf::runtime::make_pooled<d_scalar>(value); }
+        template<> inline std::shared_ptr<sqf::runtime::data> to_data<double>(double value)               { return sqf::runtime::make_pooled<d_scalar>(value); }
     }
 
 }
\ No newline at end of file
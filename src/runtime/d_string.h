@@ -7,6 +7,7 @@
 #include "data.h"
 #include "type.h"
 #include "value.h"
+#include "pool_allocator.h"
 
 
 namespace sqf
@@ -100,12 +101,12 @@ namespace sqf
         };
 
         template<>
-        inline std::shared_ptr<sqf::runtime::data> to_data<const char*>(const char* str) { return std::make_shared<d_string>(std::string(str)); }
+        inline std::shared_ptr<sqf::runtime::data> to_data<const char*>(const char* str) { return sqf::runtime::make_pooled<d_string>(std::string(str)); }
         template<>
-        inline std::shared_ptr<sqf::runtime::data> to_data<char>(char value) { return std::make_shared<d_string>(std::string(&value, &value + 1)); }
+        inline std::shared_ptr<sqf::runtime::data> to_data<char>(char value) { return sqf::runtime::make_pooled<d_string>(std::string(&value, &value + 1)); }
         template<>
-        inline std::shared_ptr<sqf::runtime::data> to_data<std::string>(std::string str) { return std::make_shared<d_string>(str); }
+        inline std::shared_ptr<sqf::runtime::data> to_data<std::string>(std::string str) { return sqf::runtime::make_pooled<d_string>(str); }
         template<>
-        inline std::shared_ptr<sqf::runtime::data> to_data<std::string_view>(std::string_view str) { return std::make_shared<d_string>(str); }
+        inline std::shared_ptr<sqf::runtime::data> to_data<std::string_view>(std::string_view str) { return sqf::runtime::make_pooled<d_string>(str); }
     }
 }
\ No newline at end of file
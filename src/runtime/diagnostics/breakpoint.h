@@ -12,7 +12,7 @@ namespace sqf::runtime::diagnostics
         bool m_enabled;
     public:
         breakpoint(std::size_t line, std::string_view file) : m_line(line), m_file(file), m_condition(), m_enabled(true) {}
-        //breakpoint(std::size_t line, std::string_view file, std::string_view condition) : m_line(line), m_file(file), m_condition(condition), m_enabled(true) {}
+        breakpoint(std::size_t line, std::string_view file, std::string_view condition) : m_line(line), m_file(file), m_condition(condition), m_enabled(true) {}
 
         void disable() { m_enabled = false; }
         void enable() { m_enabled = true; }
@@ -24,7 +24,11 @@ namespace sqf::runtime::diagnostics
         std::string_view file() const { return m_file; }
         void file(std::string value) { m_file = value; }
 
-        // std::string condition() const { return m_condition; }
-        // void condition(std::string value) { m_condition = value; }
+        /// <summary>
+        /// SQF expression that has to evaluate to true for the breakpoint to halt execution.
+        /// Empty if the breakpoint is unconditional.
+        /// </summary>
+        std::string_view condition() const { return m_condition; }
+        void condition(std::string value) { m_condition = value; }
     };
 }
\ No newline at end of file
@@ -3,12 +3,29 @@
 
 #include <string>
 #include <string_view>
+#include <memory>
+#include <algorithm>
+#include <unordered_map>
 
 
 namespace sqf::runtime::diagnostics
 {
     class diag_info
     {
+    private:
+        // The path of this diag_info. Shared with all other diag_info of the same file.
+        std::shared_ptr<const sqf::runtime::fileio::pathinfo> m_path;
+        // The contents adjusted_offset and length point into.
+        // Shared with all other diag_info created from the same contents.
+        std::shared_ptr<const std::string> m_contents;
+        // If true, m_contents holds the code segment itself rather than the contents it is created from.
+        bool m_verbatim;
+
+        static const sqf::runtime::fileio::pathinfo& empty_path()
+        {
+            static const sqf::runtime::fileio::pathinfo empty;
+            return empty;
+        }
     public:
         // The line this diag_info was created at
         size_t line;
@@ -18,30 +35,30 @@ namespace sqf::runtime::diagnostics
         size_t adjusted_offset;
         // The original file offset, before preprocessing, this diag_info was created at.
         size_t file_offset;
-        // The original file offset, before preprocessing, this diag_info was created at.
+        // The length of the code this diag_info was created for.
         size_t length;
-        // The path of this diag_info
-        sqf::runtime::fileio::pathinfo path;
-        // A view from the file, that can be used for diagnostics
-        std::string code_segment;
 
-        bool operator==(const diag_info& b) const { return line == b.line && column == b.column && file_offset == b.file_offset && path == b.path && code_segment == b.code_segment; }
-        bool operator!=(const diag_info& b) const { return line != b.line || column != b.column || file_offset != b.file_offset || path != b.path || code_segment != b.code_segment; }
+        bool operator==(const diag_info& b) const { return line == b.line && column == b.column && file_offset == b.file_offset && path() == b.path(); }
+        bool operator!=(const diag_info& b) const { return !(*this == b); }
 
-        diag_info() : diag_info(0, 0, 0, 0, {}, "") {}
+        diag_info() :
+            m_path(),
+            m_contents(),
+            m_verbatim(true),
+            line(0),
+            column(0),
+            adjusted_offset(0),
+            file_offset(0),
+            length(0)
+        {
+        }
         diag_info(
             size_t line,
             size_t column,
             size_t file_offset,
             sqf::runtime::fileio::pathinfo path,
             std::string code_segment) :
-            line(line),
-            column(column),
-            adjusted_offset(file_offset),
-            file_offset(file_offset),
-            length(0),
-            path(path),
-            code_segment(code_segment)
+            diag_info(line, column, file_offset, file_offset, path, code_segment)
         {
         }
         diag_info(
@@ -51,16 +68,134 @@ namespace sqf::runtime::diagnostics
             size_t file_offset,
             sqf::runtime::fileio::pathinfo path,
             std::string code_segment) :
+            m_path(std::make_shared<const sqf::runtime::fileio::pathinfo>(std::move(path))),
+            m_contents(code_segment.empty() ? nullptr : std::make_shared<const std::string>(std::move(code_segment))),
+            m_verbatim(true),
             line(line),
             column(column),
             adjusted_offset(adjusted_offset),
             file_offset(file_offset),
-            length(0),
-            path(path),
-            code_segment(code_segment)
+            length(0)
+        {
+        }
+        /// <summary>
+        /// Creates a diag_info that shares path and contents with others.
+        /// The code segment gets created from contents on demand.
+        /// </summary>
+        diag_info(
+            size_t line,
+            size_t column,
+            size_t offset,
+            size_t length,
+            std::shared_ptr<const sqf::runtime::fileio::pathinfo> path,
+            std::shared_ptr<const std::string> contents) :
+            m_path(std::move(path)),
+            m_contents(std::move(contents)),
+            m_verbatim(false),
+            line(line),
+            column(column),
+            adjusted_offset(offset),
+            file_offset(offset),
+            length(length)
+        {
+        }
+
+        const sqf::runtime::fileio::pathinfo& path() const { return m_path ? *m_path : empty_path(); }
+        void path(sqf::runtime::fileio::pathinfo value) { m_path = std::make_shared<const sqf::runtime::fileio::pathinfo>(std::move(value)); }
+        void path(std::shared_ptr<const sqf::runtime::fileio::pathinfo> value) { m_path = std::move(value); }
+
+        /// <summary>
+        /// A view from the file, that can be used for diagnostics.
+        /// Created on every call, hence only meant for reporting.
+        /// </summary>
+        std::string code_segment() const
+        {
+            if (!m_contents)
+            {
+                return {};
+            }
+            if (m_verbatim)
+            {
+                return *m_contents;
+            }
+            return create_code_segment(*m_contents, adjusted_offset, length);
+        }
+        void code_segment(std::shared_ptr<const std::string> value)
+        {
+            m_contents = std::move(value);
+            m_verbatim = true;
+        }
+
+        operator sqf::runtime::fileio::pathinfo() const { return path(); }
+
+        /// <summary>
+        /// Creates a code segment, consisting of the line around the provided offset
+        /// and a second line marking the code at offset using '^'.
+        /// </summary>
+        static std::string create_code_segment(std::string_view view, size_t off, size_t length)
         {
+            size_t i = off < 15 ? 0 : off - 15;
+            size_t len = 30 + length;
+            for (size_t j = i; j < i + len && j < view.length(); j++)
+            {
+                char wc = view[j];
+                if (wc == '\n')
+                {
+                    if (j < off)
+                    {
+                        i = j + 1;
+                    }
+                    else
+                    {
+                        len = j - i;
+                        break;
+                    }
+                }
+            }
+
+            std::string spacing(off - i, ' ');
+            std::string postfix(std::max<size_t>(1, length), '^');
+
+            std::string txt;
+            txt.reserve(len + 1 + spacing.length() + postfix.length() + 1);
+            txt.append(view.substr(std::min(i, view.length()), len));
+            txt.append("\n");
+            txt.append(spacing);
+            txt.append(postfix);
+            txt.append("\n");
+            return txt;
         }
+    };
 
-        operator sqf::runtime::fileio::pathinfo() const { return path; }
+    /// <summary>
+    /// Creates the diag_info for a single parsed contents.
+    /// All of them share the contents and, per file, the path, instead of carrying copies.
+    /// </summary>
+    class source_table
+    {
+    private:
+        std::shared_ptr<const std::string> m_contents;
+        std::unordered_map<std::string, std::shared_ptr<const sqf::runtime::fileio::pathinfo>> m_paths;
+    public:
+        source_table(std::string contents) : m_contents(std::make_shared<const std::string>(std::move(contents))) {}
+
+        std::string_view contents() const { return *m_contents; }
+
+        std::shared_ptr<const sqf::runtime::fileio::pathinfo> path(std::string_view physical)
+        {
+            auto res = m_paths.find(std::string(physical));
+            if (res != m_paths.end())
+            {
+                return res->second;
+            }
+            auto path = std::make_shared<const sqf::runtime::fileio::pathinfo>(physical, std::string_view{});
+            m_paths.emplace(std::string(physical), path);
+            return path;
+        }
+
+        diag_info create(size_t line, size_t column, size_t offset, size_t length, std::string_view physical)
+        {
+            return { line, column, offset, length, path(physical), m_contents };
+        }
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,173 @@
+#include "profiler.h"
+#include "../context.h"
+
+#include <map>
+#include <tuple>
+#include <iomanip>
+#include <algorithm>
+
+size_t sqf::runtime::diagnostics::profiler::stack_id(sqf::runtime::context& context)
+{
+    auto root = context.current_frame().instructions().empty() ? nullptr : context.current_frame().instructions().begin()->get();
+    if (m_stack_context == &context && m_stack_depth == context.frames_size() && m_stack_root == root && !m_stacks.empty())
+    {
+        return m_stack_id;
+    }
+    m_stack_context = &context;
+    m_stack_depth = context.frames_size();
+    m_stack_root = root;
+
+    std::vector<std::string_view> labels;
+    for (auto it = context.frames_rbegin(); it != context.frames_rend(); ++it)
+    {
+        labels.push_back(frame_label(*it));
+    }
+    std::string folded = context.name().empty() ? "<context>" : context.name();
+    for (auto it = labels.rbegin(); it != labels.rend(); ++it)
+    {
+        folded.push_back(';');
+        folded.append(*it);
+    }
+
+    auto res = m_stack_ids.find(folded);
+    if (res != m_stack_ids.end())
+    {
+        m_stack_id = res->second;
+    }
+    else
+    {
+        m_stack_id = m_stacks.size();
+        m_stack_ids[folded] = m_stack_id;
+        m_stacks.push_back({ std::move(folded), {} });
+    }
+    return m_stack_id;
+}
+
+std::string_view sqf::runtime::diagnostics::profiler::frame_label(const sqf::runtime::frame& frame)
+{
+    if (!frame.scope_name().empty())
+    {
+        return frame.scope_name();
+    }
+    if (frame.instructions().empty())
+    {
+        return "<empty>";
+    }
+    // Frames without scope name are labeled by the location their instructions start at.
+    auto& instruction = *frame.instructions().begin();
+    auto res = m_frame_labels.find(instruction.get());
+    if (res != m_frame_labels.end())
+    {
+        return res->second.second;
+    }
+    auto& dinf = instruction->diag_info();
+    auto label = dinf.path().physical + ":" + std::to_string(dinf.line);
+    // Semicolons separate the frames of folded stacks.
+    std::replace(label.begin(), label.end(), ';', ',');
+    return m_frame_labels.emplace(instruction.get(), std::make_pair(instruction, std::move(label))).first->second.second;
+}
+
+void sqf::runtime::diagnostics::profiler::record(sqf::runtime::context& context, const sqf::runtime::instruction::sptr& instruction)
+{
+    auto now = std::chrono::steady_clock::now();
+    if (m_last_instruction)
+    {
+        auto elapsed = now - m_last_timestamp;
+        m_last_instruction->time += elapsed;
+        m_stacks[m_last_stack].totals.time += elapsed;
+    }
+
+    auto res = m_instructions.find(instruction.get());
+    if (res == m_instructions.end())
+    {
+        res = m_instructions.emplace(instruction.get(), instruction_sample{ instruction, {} }).first;
+    }
+    auto stack = stack_id(context);
+    res->second.totals.instructions++;
+    m_stacks[stack].totals.instructions++;
+
+    m_last_instruction = &res->second.totals;
+    m_last_stack = stack;
+    m_last_timestamp = now;
+}
+
+void sqf::runtime::diagnostics::profiler::pause()
+{
+    if (m_last_instruction)
+    {
+        auto elapsed = std::chrono::steady_clock::now() - m_last_timestamp;
+        m_last_instruction->time += elapsed;
+        m_stacks[m_last_stack].totals.time += elapsed;
+        m_last_instruction = nullptr;
+    }
+    // Frames might be gone once execution continues.
+    m_stack_context = nullptr;
+}
+
+void sqf::runtime::diagnostics::profiler::clear()
+{
+    m_instructions.clear();
+    m_stacks.clear();
+    m_stack_ids.clear();
+    m_frame_labels.clear();
+    m_stack_context = nullptr;
+    m_last_instruction = nullptr;
+}
+
+void sqf::runtime::diagnostics::profiler::write_folded(std::ostream& out) const
+{
+    for (auto& it : m_stacks)
+    {
+        if (it.totals.instructions > 0)
+        {
+            out << it.folded << ' ' << it.totals.instructions << '\n';
+        }
+    }
+}
+
+void sqf::runtime::diagnostics::profiler::write_hot_lines(std::ostream& out, size_t count) const
+{
+    struct line_sample
+    {
+        sample totals;
+        std::string code_segment;
+    };
+    std::map<std::tuple<std::string, size_t>, line_sample> lines;
+    sample overall;
+    for (auto& it : m_instructions)
+    {
+        auto& dinf = it.second.instruction->diag_info();
+        auto& line = lines[{ dinf.path().physical, dinf.line }];
+        line.totals.instructions += it.second.totals.instructions;
+        line.totals.time += it.second.totals.time;
+        if (line.code_segment.empty())
+        {
+            auto code_segment = dinf.code_segment();
+            line.code_segment = code_segment.substr(0, code_segment.find('\n'));
+        }
+        overall.instructions += it.second.totals.instructions;
+        overall.time += it.second.totals.time;
+    }
+
+    std::vector<decltype(lines)::const_iterator> sorted;
+    for (auto it = lines.begin(); it != lines.end(); ++it)
+    {
+        sorted.push_back(it);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](auto& l, auto& r) { return l->second.totals.time > r->second.totals.time; });
+    if (sorted.size() > count)
+    {
+        sorted.resize(count);
+    }
+
+    out << std::setw(12) << "TIME (ms)" << std::setw(8) << "%" << std::setw(14) << "INSTRUCTIONS" << "  LOCATION" << '\n';
+    for (auto& it : sorted)
+    {
+        auto ms = std::chrono::duration<double, std::milli>(it->second.totals.time).count();
+        auto percentage = overall.time.count() == 0 ? 0.0 : 100.0 * it->second.totals.time.count() / overall.time.count();
+        out << std::fixed << std::setprecision(3) << std::setw(12) << ms <<
+            std::setprecision(1) << std::setw(8) << percentage <<
+            std::setw(14) << it->second.totals.instructions << "  " <<
+            "[L" << std::get<1>(it->first) << "|" << std::get<0>(it->first) << "]  " << it->second.code_segment << '\n';
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include "../instruction.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <ostream>
+
+namespace sqf::runtime
+{
+    class context;
+    class frame;
+}
+namespace sqf::runtime::diagnostics
+{
+    /// <summary>
+    /// Attributes executed instructions and the wall time spent on them
+    /// to the stack of frames they were executed in and to their source line.
+    /// </summary>
+    /// <remarks>
+    /// The time spent on an instruction is the time until the next instruction got recorded.
+    /// pause() has to be called whenever execution stops, so that idle time does not get attributed.
+    /// </remarks>
+    class profiler
+    {
+    public:
+        struct sample
+        {
+            size_t instructions = 0;
+            std::chrono::nanoseconds time = std::chrono::nanoseconds::zero();
+        };
+    private:
+        struct instruction_sample
+        {
+            sqf::runtime::instruction::sptr instruction;
+            sample totals;
+        };
+        struct stack_sample
+        {
+            std::string folded;
+            sample totals;
+        };
+
+        std::unordered_map<const sqf::runtime::instruction*, instruction_sample> m_instructions;
+        std::vector<stack_sample> m_stacks;
+        std::unordered_map<std::string, size_t> m_stack_ids;
+        std::unordered_map<const sqf::runtime::instruction*, std::pair<sqf::runtime::instruction::sptr, std::string>> m_frame_labels;
+
+        // The stack recorded last, rebuilt only if context, frame count or the instructions of the current frame change.
+        const sqf::runtime::context* m_stack_context;
+        size_t m_stack_depth;
+        const sqf::runtime::instruction* m_stack_root;
+        size_t m_stack_id;
+
+        sample* m_last_instruction;
+        size_t m_last_stack;
+        std::chrono::steady_clock::time_point m_last_timestamp;
+
+        size_t stack_id(sqf::runtime::context& context);
+        std::string_view frame_label(const sqf::runtime::frame& frame);
+    public:
+        profiler() :
+            m_stack_context(nullptr),
+            m_stack_depth(0),
+            m_stack_root(nullptr),
+            m_stack_id(0),
+            m_last_instruction(nullptr),
+            m_last_stack(0)
+        {}
+
+        /// <summary>
+        /// Records the instruction about to be executed as current instruction of the provided context.
+        /// </summary>
+        void record(sqf::runtime::context& context, const sqf::runtime::instruction::sptr& instruction);
+
+        /// <summary>
+        /// Stops attributing time to the instruction recorded last.
+        /// </summary>
+        void pause();
+
+        /// <summary>
+        /// Discards everything recorded so far.
+        /// </summary>
+        void clear();
+
+        /// <summary>
+        /// Writes one line per recorded stack, with the frames separated by semicolons,
+        /// followed by the amount of instructions executed in it.
+        /// The output is compatible with flamegraph.pl and similar tools.
+        /// </summary>
+        void write_folded(std::ostream& out) const;
+
+        /// <summary>
+        /// Writes a table of the top source lines, by the amount of time spent executing them.
+        /// </summary>
+        /// <param name="out">The stream to write to.</param>
+        /// <param name="count">The maximum amount of lines to report.</param>
+        void write_hot_lines(std::ostream& out, size_t count) const;
+    };
+}
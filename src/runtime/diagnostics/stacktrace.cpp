@@ -18,7 +18,7 @@ std::string sqf::runtime::diagnostics::stacktrace::to_string() const
             LogLocationInfo((*frame.current())->diag_info()).format() <<
             "[" << (frame.globals_value_scope()->scope_name().empty() ? "SCOPENAME-NA" : frame.globals_value_scope()->scope_name()) << "] " <<
             "[" << (frame.scope_name().empty() ? "SCOPENAME-EMPTY" : frame.scope_name()) << "]" << std::endl <<
-            (*frame.current())->diag_info().code_segment << std::endl;
+            (*frame.current())->diag_info().code_segment() << std::endl;
     }
     return sstream.str();
 }
\ No newline at end of file
@@ -99,23 +99,25 @@ namespace sqf::runtime
         frame() :
             frame({}, {}, {}, {}) {}
         frame(std::shared_ptr<sqf::runtime::value_scope> globals_scope, sqf::runtime::instruction_set instruction_set, std::shared_ptr<behavior> exit_behavior) :
-            frame(globals_scope, instruction_set, exit_behavior, {}) {}
+            frame(std::move(globals_scope), std::move(instruction_set), std::move(exit_behavior), {}) {}
         frame(std::shared_ptr<sqf::runtime::value_scope> globals_scope, sqf::runtime::instruction_set instruction_set) :
-            frame(globals_scope, instruction_set, {}, {}) {}
+            frame(std::move(globals_scope), std::move(instruction_set), {}, {}) {}
         frame(std::shared_ptr<sqf::runtime::value_scope> globals_scope,
             sqf::runtime::instruction_set instruction_set,
             std::shared_ptr<behavior> exit_behavior,
             std::shared_ptr<behavior> error_behavior)
             :
-            m_instruction_set(instruction_set),
+            m_instruction_set(std::move(instruction_set)),
             m_position(position_invalid),
-            m_exit_behavior(exit_behavior),
-            m_error_behavior(error_behavior),
-            m_globals_value_scope(globals_scope),
+            m_exit_behavior(std::move(exit_behavior)),
+            m_error_behavior(std::move(error_behavior)),
+            m_globals_value_scope(std::move(globals_scope)),
             m_bubble_variable(true),
             m_started(false),
             m_die(false)
-        {}
+        {
+            layout(m_instruction_set.layout());
+        }
 
 #ifdef DF__SQF_RUNTIME__ASSEMBLY_DEBUG_ON_EXECUTE
 
@@ -158,6 +160,7 @@ namespace sqf::runtime
                 return result::ok;
             case behavior::result::exchange:
                 m_instruction_set = m_error_behavior->get_instruction_set(*this);
+                layout(m_instruction_set.layout());
                 seek(0, ::sqf::runtime::frame::seekpos::start);
 #ifdef DF__SQF_RUNTIME__ASSEMBLY_DEBUG_ON_EXECUTE
 
@@ -240,6 +243,8 @@ namespace sqf::runtime
         void bubble_variable(bool flag) { m_bubble_variable = flag; }
 
         sqf::runtime::instruction_set::iterator current() const { return m_instruction_set.begin() + m_position; }
+        const sqf::runtime::instruction_set& instructions() const { return m_instruction_set; }
+        const sqf::runtime::bytecode& bytecode() const { return m_instruction_set.bytecode(); }
         std::shared_ptr<sqf::runtime::value_scope> globals_value_scope() const { return m_globals_value_scope; }
         void globals_value_scope(std::shared_ptr<sqf::runtime::value_scope> scope) { m_globals_value_scope = scope; }
 
@@ -288,6 +293,7 @@ namespace sqf::runtime
                     goto start; // do not call here, reuse current stack
                 case behavior::result::exchange:
                     m_instruction_set = m_exit_behavior->get_instruction_set(*this);
+                    layout(m_instruction_set.layout());
                     seek(0, ::sqf::runtime::frame::seekpos::start);
 #ifdef DF__SQF_RUNTIME__ASSEMBLY_DEBUG_ON_EXECUTE
 
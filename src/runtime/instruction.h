@@ -1,10 +1,14 @@
 #pragma once
 #include "diagnostics/diag_info.h"
+#include "symbol.h"
+#include "local_layout.h"
+#include "bytecode.h"
 
 #include <string>
 #include <memory>
 #include <vector>
 #include <optional>
+#include <typeinfo>
 
 namespace sqf::runtime
 {
@@ -16,6 +20,7 @@ namespace sqf::runtime
     private:
         sqf::runtime::diagnostics::diag_info m_diag_info;
     public:
+        static std::size_t hash_combine(std::size_t seed, std::size_t value) { return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2)); }
         virtual ~instruction() {};
         virtual void execute(runtime& runtime) const = 0;
         virtual std::string to_string() const = 0;
@@ -25,7 +30,30 @@ namespace sqf::runtime
             short parent_precedence, bool left_from_binary) const = 0;
         virtual bool equals(const instruction* p_other) const = 0;
 
-        sqf::runtime::diagnostics::diag_info diag_info() const { return m_diag_info; }
+        /// <summary>
+        /// Structural hash of this instruction, instructions that are equal must hash equal.
+        /// Defaults to hashing to_string(), opcodes may provide a cheaper one.
+        /// </summary>
+        virtual std::size_t hash() const { return std::hash<std::string>()(to_string()); }
+
+        /// <summary>
+        /// The local variable accessed by this instruction, if any.
+        /// Used by sqf::runtime::instruction_set to assign slots to local variables.
+        /// </summary>
+        virtual const sqf::runtime::symbol* local_variable() const { return nullptr; }
+
+        /// <summary>
+        /// Tells the instruction which slot its local variable got assigned in the provided layout.
+        /// </summary>
+        virtual void local_slot(std::shared_ptr<const sqf::runtime::local_layout> layout, size_t slot) {}
+
+        /// <summary>
+        /// Appends the bytecode form of this instruction.
+        /// Must emit exactly one op.
+        /// </summary>
+        virtual void lower(sqf::runtime::bytecode& code) const { code.emit_instruction(); }
+
+        const sqf::runtime::diagnostics::diag_info& diag_info() const { return m_diag_info; }
         void diag_info(sqf::runtime::diagnostics::diag_info dinf) { m_diag_info = dinf; }
     };
 }
\ No newline at end of file
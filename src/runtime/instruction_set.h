@@ -3,11 +3,16 @@
 
 #include <vector>
 #include <initializer_list>
+#include <memory>
+#include <algorithm>
 
 namespace sqf::runtime
 {
     /// <summary>
     /// A way to represent a "immutable" instruction set.
+    /// Local variables accessed by the instructions get assigned to slots
+    /// and the bytecode form gets created on construction.
+    /// Copies share the instructions, making them cheap to hand over to frames.
     /// </summary>
     class instruction_set final
     {
@@ -15,17 +20,72 @@ namespace sqf::runtime
         using iterator = std::vector<sqf::runtime::instruction::sptr>::const_iterator;
         using reverse_iterator = std::vector<sqf::runtime::instruction::sptr>::const_reverse_iterator;
     private:
-        std::vector<sqf::runtime::instruction::sptr> m_instructions;
+        std::shared_ptr<const std::vector<sqf::runtime::instruction::sptr>> m_instructions;
+        std::shared_ptr<const sqf::runtime::local_layout> m_layout;
+        std::shared_ptr<const sqf::runtime::bytecode> m_bytecode;
+
+        const std::vector<sqf::runtime::instruction::sptr>& instructions() const
+        {
+            static const std::vector<sqf::runtime::instruction::sptr> empty;
+            return m_instructions ? *m_instructions : empty;
+        }
+
+        void lower()
+        {
+            auto code = std::make_shared<sqf::runtime::bytecode>();
+            for (auto& it : instructions())
+            {
+                it->lower(*code);
+            }
+            m_bytecode = code;
+        }
+
+        void bind_locals()
+        {
+            std::vector<sqf::runtime::symbol> symbols;
+            for (auto& it : instructions())
+            {
+                auto variable = it->local_variable();
+                if (variable && std::find(symbols.begin(), symbols.end(), *variable) == symbols.end())
+                {
+                    symbols.push_back(*variable);
+                }
+            }
+            if (symbols.empty())
+            {
+                return;
+            }
+            m_layout = std::make_shared<const sqf::runtime::local_layout>(std::move(symbols));
+            for (auto& it : instructions())
+            {
+                if (auto variable = it->local_variable())
+                {
+                    it->local_slot(m_layout, m_layout->index_of(*variable));
+                }
+            }
+        }
     public:
         instruction_set() {}
-        instruction_set(std::initializer_list<sqf::runtime::instruction::sptr> initializer) : m_instructions(initializer.begin(), initializer.end()) {}
-        instruction_set(std::vector<sqf::runtime::instruction::sptr> instructions) : m_instructions(std::move(instructions)) {}
+        instruction_set(std::initializer_list<sqf::runtime::instruction::sptr> initializer) :
+            m_instructions(std::make_shared<const std::vector<sqf::runtime::instruction::sptr>>(initializer.begin(), initializer.end())) { bind_locals(); lower(); }
+        instruction_set(std::vector<sqf::runtime::instruction::sptr> instructions) :
+            m_instructions(std::make_shared<const std::vector<sqf::runtime::instruction::sptr>>(std::move(instructions))) { bind_locals(); lower(); }
 
-        iterator begin() const { return m_instructions.begin(); }
-        iterator end() const { return m_instructions.end(); }
-        reverse_iterator rbegin() const { return m_instructions.rbegin(); }
-        reverse_iterator rend() const { return m_instructions.rend(); }
-        bool empty() const { return m_instructions.empty(); }
-        size_t size() const { return m_instructions.size(); }
+        iterator begin() const { return instructions().begin(); }
+        iterator end() const { return instructions().end(); }
+        reverse_iterator rbegin() const { return instructions().rbegin(); }
+        reverse_iterator rend() const { return instructions().rend(); }
+        bool empty() const { return instructions().empty(); }
+        /// <summary>
+        /// Whether both instruction sets are copies of one another, sharing the very same instructions.
+        /// </summary>
+        bool shares_instructions(const instruction_set& other) const { return m_instructions == other.m_instructions; }
+        size_t size() const { return instructions().size(); }
+        std::shared_ptr<const sqf::runtime::local_layout> layout() const { return m_layout; }
+        const sqf::runtime::bytecode& bytecode() const
+        {
+            static const sqf::runtime::bytecode empty;
+            return m_bytecode ? *m_bytecode : empty;
+        }
     };
 }
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+#include "symbol.h"
+
+#include <vector>
+#include <unordered_map>
+
+namespace sqf::runtime
+{
+    /// <summary>
+    /// Slot assignment of the local variables accessed by a single instruction_set.
+    /// A frame executing that instruction_set stores those variables in a plain array,
+    /// indexed by the slot, instead of its variable map.
+    /// </summary>
+    class local_layout
+    {
+    private:
+        std::vector<sqf::runtime::symbol> m_symbols;
+        std::unordered_map<sqf::runtime::symbol, size_t> m_indices;
+    public:
+        static const size_t npos = ~(size_t)0;
+        local_layout(std::vector<sqf::runtime::symbol> symbols) : m_symbols(std::move(symbols))
+        {
+            m_indices.reserve(m_symbols.size());
+            for (size_t i = 0; i < m_symbols.size(); i++)
+            {
+                m_indices.emplace(m_symbols[i], i);
+            }
+        }
+
+        size_t size() const { return m_symbols.size(); }
+        const sqf::runtime::symbol& at(size_t slot) const { return m_symbols[slot]; }
+
+        /// <summary>
+        /// Receives the slot of the provided variable.
+        /// </summary>
+        /// <returns>The slot or npos if the variable has no slot in this layout.</returns>
+        size_t index_of(const sqf::runtime::symbol& variable) const
+        {
+            auto res = m_indices.find(variable);
+            return res == m_indices.end() ? npos : res->second;
+        }
+    };
+}
@@ -6,15 +6,24 @@ using namespace std::string_view_literals;
 
 #pragma region StdOutLogger
 void StdOutLogger::log(const LogMessageBase& message) {
+    // Formatted up front to hold the lock only for the write, as multiple runtimes may log concurrently.
+    std::string line;
+    line.append(Logger::loglevelstring(message.getLevel()));
+    line.push_back(' ');
+    line.append(message.formatMessage());
+    line.push_back('\n');
+
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
     auto& logTarget = std::cout;
-    logTarget << Logger::loglevelstring(message.getLevel()) << ' ' << message.formatMessage() << std::endl;
+    logTarget << line << std::flush;
 }
 #pragma endregion StdOutLogger
 
 #pragma region LogLocationInfo
 LogLocationInfo::LogLocationInfo(const sqf::runtime::diagnostics::diag_info& info)
 {
-    path = info.path.physical;
+    path = info.path().physical;
     line = info.line;
     col =  info.column;
 }
@@ -2831,6 +2840,23 @@ namespace logmessage::runtime
         output.append(" }"sv);
         return output;
     }
+    std::string MaximumInstructionsReached::formatMessage() const
+    {
+        auto output = m_location.format();
+        auto maximum_instructions = to_cardinal_string(m_maximum_instructions);
+
+        output.reserve(
+            output.length()
+            + "Maximum of "sv.length()
+            + maximum_instructions.length()
+            + " instructions per context reached. Context got terminated."sv.length()
+        );
+
+        output.append("Maximum of "sv);
+        output.append(maximum_instructions);
+        output.append(" instructions per context reached. Context got terminated."sv);
+        return output;
+    }
 }
 
 std::string logmessage::fileio::ResolveVirtualRequested::formatMessage() const
@@ -1833,6 +1833,17 @@ namespace logmessage {
             {}
             [[nodiscard]] std::string formatMessage() const override;
         };
+        class MaximumInstructionsReached : public RuntimeBase {
+            static const loglevel level = loglevel::error;
+            static const size_t errorCode = 60099;
+            size_t m_maximum_instructions;
+        public:
+            MaximumInstructionsReached(LogLocationInfo loc, size_t maximum_instructions) :
+                RuntimeBase(level, errorCode, std::move(loc)),
+                m_maximum_instructions(maximum_instructions)
+            {}
+            [[nodiscard]] std::string formatMessage() const override;
+        };
     }
     namespace fileio
     {
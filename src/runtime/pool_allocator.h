@@ -0,0 +1,134 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace sqf::runtime
+{
+    /// <summary>
+    /// Free list of equally sized blocks, kept per thread.
+    /// Blocks released are kept for reuse (up to max_cached) instead of being handed back to the heap.
+    /// </summary>
+    template<size_t Size, size_t Align>
+    class block_pool
+    {
+    private:
+        struct node { node* next; };
+        static constexpr size_t block_size = Size < sizeof(node) ? sizeof(node) : Size;
+        static constexpr size_t block_align = Align < alignof(node) ? alignof(node) : Align;
+        static constexpr size_t max_cached = 4096;
+
+        node* m_head = nullptr;
+        size_t m_cached = 0;
+
+        // Trivially destructible, hence still readable while thread_local objects get destroyed.
+        static bool& alive()
+        {
+            thread_local bool flag = false;
+            return flag;
+        }
+
+        block_pool() { alive() = true; }
+        ~block_pool()
+        {
+            alive() = false;
+            while (m_head)
+            {
+                auto next = m_head->next;
+                ::operator delete(static_cast<void*>(m_head), std::align_val_t(block_align));
+                m_head = next;
+            }
+        }
+        void* pop()
+        {
+            if (m_head)
+            {
+                auto res = m_head;
+                m_head = m_head->next;
+                m_cached--;
+                return res;
+            }
+            return ::operator new(block_size, std::align_val_t(block_align));
+        }
+        void push(void* ptr)
+        {
+            if (m_cached == max_cached)
+            {
+                ::operator delete(ptr, std::align_val_t(block_align));
+                return;
+            }
+            auto n = static_cast<node*>(ptr);
+            n->next = m_head;
+            m_head = n;
+            m_cached++;
+        }
+        static block_pool* instance()
+        {
+            thread_local block_pool pool;
+            return &pool;
+        }
+    public:
+        static void* allocate()
+        {
+            return instance()->pop();
+        }
+        static void deallocate(void* ptr)
+        {
+            if (!alive())
+            { // Released after the pool of this thread is gone (eg. by static destructors).
+                ::operator delete(ptr, std::align_val_t(block_align));
+                return;
+            }
+            instance()->push(ptr);
+        }
+    };
+
+    /// <summary>
+    /// Allocator serving single object allocations from a block_pool.
+    /// Meant for the short lived data the VM creates all the time (eg. via std::allocate_shared),
+    /// so that those get recycled rather than going through the global heap every time.
+    /// </summary>
+    template<class T>
+    class pool_allocator
+    {
+    public:
+        using value_type = T;
+
+        pool_allocator() noexcept = default;
+        template<class U>
+        pool_allocator(const pool_allocator<U>&) noexcept {}
+
+        T* allocate(size_t n)
+        {
+            if (n != 1)
+            {
+                return std::allocator<T>().allocate(n);
+            }
+            return static_cast<T*>(block_pool<sizeof(T), alignof(T)>::allocate());
+        }
+        void deallocate(T* ptr, size_t n) noexcept
+        {
+            if (n != 1)
+            {
+                std::allocator<T>().deallocate(ptr, n);
+                return;
+            }
+            block_pool<sizeof(T), alignof(T)>::deallocate(ptr);
+        }
+
+        template<class U>
+        bool operator==(const pool_allocator<U>&) const noexcept { return true; }
+        template<class U>
+        bool operator!=(const pool_allocator<U>&) const noexcept { return false; }
+    };
+
+    /// <summary>
+    /// std::make_shared counterpart, placing object and control block into a pooled block.
+    /// </summary>
+    template<class T, class... TArgs>
+    std::shared_ptr<T> make_pooled(TArgs&&... args)
+    {
+        return std::allocate_shared<T>(pool_allocator<T>(), std::forward<TArgs>(args)...);
+    }
+}
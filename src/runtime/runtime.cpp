@@ -2,6 +2,7 @@
 #include "diagnostics/stacktrace.h"
 #include "d_array.h"
 #include "d_string.h"
+#include "d_boolean.h"
 #include "diagnostics/d_stacktrace.h"
 
 #include <optional>
@@ -15,6 +16,9 @@ static sqf::runtime::runtime::result execute_do(sqf::runtime::runtime& runtime,
 {
     auto& context_active = runtime.context_active();
     auto& runtime_error = runtime.__runtime_error();
+    auto profiler = runtime.profiler();
+    // Whatever happens until the next call must not be attributed to the instruction executed last.
+    struct pause_profiler { sqf::runtime::diagnostics::profiler* profiler; ~pause_profiler() { if (profiler) { profiler->pause(); } } } pause_guard{ profiler };
     while (true)
     {
         if (runtime.is_exit_requested())
@@ -95,8 +99,7 @@ static sqf::runtime::runtime::result execute_do(sqf::runtime::runtime& runtime,
         }
 
         auto instruction = frame.current();
-        if (runtime.configuration().max_runtime != std::chrono::milliseconds::zero() &&
-            runtime.configuration().max_runtime + runtime.runtime_timestamp() < std::chrono::system_clock::now())
+        if (runtime.configuration().max_runtime != std::chrono::milliseconds::zero() && runtime.max_runtime_reached())
         {
 #ifdef DF__SQF_RUNTIME__ASSEMBLY_DEBUG_ON_EXECUTE
             std::cout << "\x1B[33m[ASSEMBLY ASSERT]\033[0m" <<
@@ -108,25 +111,39 @@ static sqf::runtime::runtime::result execute_do(sqf::runtime::runtime& runtime,
             runtime.exit(0);
             return sqf::runtime::runtime::result::ok;
         }
+        if (context_active.instruction_budget_exhausted())
+        {
+#ifdef DF__SQF_RUNTIME__ASSEMBLY_DEBUG_ON_EXECUTE
+            std::cout << "\x1B[33m[ASSEMBLY ASSERT]\033[0m" <<
+                "        " <<
+                "        " <<
+                "    " << "\x1B[36mEXIT execute_do\033[0m as instruction budget (\x1B[90m" << context_active.instruction_budget() << "\033[0m) was exhausted" << std::endl;
+#endif // DF__SQF_RUNTIME__ASSEMBLY_DEBUG_ON_EXECUTE
+            runtime.__logmsg(logmessage::runtime::MaximumInstructionsReached((*instruction)->diag_info(), context_active.instruction_budget()));
+            runtime_error = false;
+            runtime.log_messages.clear();
+            // Only this context gets terminated, others keep running.
+            context_active.clear_frames();
+            context_active.clear_values(true);
+            return sqf::runtime::runtime::result::empty;
+        }
 
         // Check if breakpoint was hit
+        if (!runtime.breakpoints().empty() && runtime.breakpoint_check(**instruction))
         {
-            auto dinf = (*instruction)->diag_info();
-            for (const auto& breakpoint : runtime.breakpoints())
-            {
-                if (breakpoint.is_enabled() && breakpoint.line() == dinf.line && breakpoint.file() == dinf.path.physical)
-                {
-                    runtime.breakpoint_hit(breakpoint);
-                    context_active.current_frame().previous(); // Unput instruction
-                    return sqf::runtime::runtime::result::ok;
-                }
-            }
+            context_active.current_frame().previous(); // Unput instruction
+            return sqf::runtime::runtime::result::ok;
         }
 
         if (exit_after > 0)
         {
             exit_after--;
         }
+        context_active.instruction_budget_consume();
+        if (profiler)
+        {
+            profiler->record(context_active, *instruction);
+        }
 
 #ifdef DF__SQF_RUNTIME__ASSEMBLY_DEBUG_ON_EXECUTE
 
@@ -203,7 +220,50 @@ static sqf::runtime::runtime::result execute_do(sqf::runtime::runtime& runtime,
 #endif // DF__SQF_RUNTIME__ASSEMBLY_DEBUG_ON_EXECUTE
 
 
-        (*instruction)->execute(runtime);
+        auto& code = frame.bytecode();
+        auto op = code[frame.position()];
+#ifndef DF__SQF_RUNTIME__ASSEMBLY_DEBUG_ON_EXECUTE
+        if (op.code != sqf::runtime::bytecode::opcode::instruction && runtime.breakpoints().empty() && !profiler)
+        {
+            // Pushes and statement ends cannot fail.
+            // Run consecutive ones back to back, without going through the checks above again.
+            while (true)
+            {
+                if (op.code == sqf::runtime::bytecode::opcode::push)
+                {
+                    context_active.push_value(code.constant(op.operand));
+                }
+                else
+                {
+                    context_active.clear_values();
+                }
+                auto next = frame.position() + 1;
+                if (exit_after == 0 || next >= code.size() || code[next].code == sqf::runtime::bytecode::opcode::instruction || context_active.instruction_budget_exhausted())
+                {
+                    break;
+                }
+                frame.next();
+                exit_after--;
+                context_active.instruction_budget_consume();
+                op = code[next];
+            }
+            runtime.log_messages.clear();
+            continue;
+        }
+#endif // DF__SQF_RUNTIME__ASSEMBLY_DEBUG_ON_EXECUTE
+
+        switch (op.code)
+        {
+        case sqf::runtime::bytecode::opcode::push:
+            context_active.push_value(code.constant(op.operand));
+            break;
+        case sqf::runtime::bytecode::opcode::end_statement:
+            context_active.clear_values();
+            break;
+        default:
+            (*instruction)->execute(runtime);
+            break;
+        }
 
 
         if (!runtime_error)
@@ -257,6 +317,8 @@ static sqf::runtime::runtime::result execute_do(sqf::runtime::runtime& runtime,
 
 sqf::runtime::runtime::result sqf::runtime::runtime::execute(sqf::runtime::runtime::action action)
 {
+    // Worker threads execute many runtimes one after another, hence the formatting is bound for this call only.
+    auto format_scope = scalar_format_scope();
     sqf::runtime::runtime::result res = result::invalid;
     bool expected = false;
     switch (action)
@@ -323,24 +385,31 @@ sqf::runtime::runtime::result sqf::runtime::runtime::execute(sqf::runtime::runti
             m_state = state::running;
             while (!m_contexts.empty())
             {
+                // If every context is suspended, there is nothing to do until the earliest one wakes up.
+                auto now = std::chrono::system_clock::now();
+                auto next_wakeup = std::chrono::system_clock::time_point::max();
+                bool idle = true;
                 for (size_t i = 0; i < m_contexts.size(); i++)
                 {
                     m_context_active = m_contexts[i];
                     if (m_context_active->suspended())
                     {
-                        if (m_context_active->wakeup_timestamp() <= std::chrono::system_clock::now())
+                        if (m_context_active->wakeup_timestamp() <= now)
                         {
                             m_context_active->unsuspend();
                             res = execute_do(*this, 150);
+                            idle = false;
                         }
                         else
                         {
+                            next_wakeup = std::min(next_wakeup, m_context_active->wakeup_timestamp());
                             res = result::ok;
                         }
                     }
                     else
                     {
                         res = execute_do(*this, 150);
+                        idle = false;
                     }
                     if (m_is_exit_requested)
                     {
@@ -348,6 +417,10 @@ sqf::runtime::runtime::result sqf::runtime::runtime::execute(sqf::runtime::runti
                         m_state = state::empty;
                         goto start_loop_exit;
                     }
+                    if (m_is_halt_requested)
+                    { // eg. due to a breakpoint being hit
+                        goto start_loop_exit;
+                    }
                     perform_evaluate();
                     switch (res)
                     {
@@ -379,6 +452,10 @@ sqf::runtime::runtime::result sqf::runtime::runtime::execute(sqf::runtime::runti
                     case sqf::runtime::runtime::result::ok: /* empty */ break;
                     }
                 }
+                if (idle)
+                {
+                    idle_until(next_wakeup);
+                }
             }
         start_loop_exit:
             switch (res)
@@ -535,6 +612,7 @@ sqf::runtime::runtime::result sqf::runtime::runtime::execute(sqf::runtime::runti
         else
         {
             m_is_exit_requested = true;
+            wakeup();
             res = result::ok;
         }
         break;
@@ -548,6 +626,7 @@ sqf::runtime::runtime::result sqf::runtime::runtime::execute(sqf::runtime::runti
             else
             {
                 m_is_exit_requested = true;
+                wakeup();
                 res = result::ok;
             }
         }
@@ -581,10 +660,37 @@ sqf::runtime::runtime::result sqf::runtime::runtime::execute(sqf::runtime::runti
     return res;
 }
 
+void sqf::runtime::runtime::idle_until(std::chrono::system_clock::time_point timestamp)
+{
+    // Waiting is capped to not depend on the clock implementation handling far away timestamps.
+    auto limit = std::chrono::system_clock::now() + std::chrono::seconds(1);
+    std::unique_lock<std::mutex> lock(m_idle_mutex);
+    m_idle_condition.wait_until(lock, std::min(timestamp, limit), [this]() { return m_is_exit_requested || m_evaluate_halt; });
+}
+
+std::optional<sqf::runtime::instruction_set> sqf::runtime::runtime::parse_sqf_cached(std::string contents, sqf::runtime::fileio::pathinfo file)
+{
+    // The optimizer changes the parse result, hence is part of the key.
+    auto optimized = configuration().enable_optimizer;
+    if (auto cached = m_compile_cache.find(contents, file, optimized))
+    {
+        return cached;
+    }
+    auto set = parser_sqf().parse(*this, contents, file);
+    if (set.has_value())
+    {
+        m_compile_cache.insert(std::move(contents), file, optimized, *set);
+    }
+    return set;
+}
+
 ::sqf::runtime::value sqf::runtime::runtime::evaluate_expression(std::string view, bool& success, bool request_halt)
 {
+    std::lock_guard<std::mutex> evaluate_lock(m_evaluate_mutex);
+    auto format_scope = scalar_format_scope();
     while (m_evaluate_halt);
     m_evaluate_halt = true;
+    wakeup();
     if (request_halt)
     {
         while (m_state == state::running);
@@ -595,15 +701,16 @@ sqf::runtime::runtime::result sqf::runtime::runtime::execute(sqf::runtime::runti
     {
         auto eval_context = context_create().lock();
         frame f(default_value_scope(), opt_set.value());
-        eval_context->push_frame(f);
+        eval_context->push_frame(std::move(f));
         auto old_active = context_active_as_shared();
         m_context_active = eval_context;
         try
         {
             while (!eval_context->empty())
             {
-                auto oldstate = m_state;
-                if (m_state == runtime::state::empty)
+                state oldstate = m_state;
+                // Evaluating at a breakpoint has to work too, hence any state but running is lifted temporarily.
+                if (m_state != runtime::state::running)
                 {
                     m_state = runtime::state::running;
                 }
@@ -644,4 +751,81 @@ sqf::runtime::runtime::result sqf::runtime::runtime::execute(sqf::runtime::runti
         success = false;
         return {};
     }
-}
\ No newline at end of file
+}
+
+bool sqf::runtime::runtime::breakpoint_check(const sqf::runtime::instruction& instruction)
+{
+    // Continuing after a breakpoint was hit must not hit it again right away.
+    // Other contexts may run in between, hence this is only reset once the instruction is reached
+    // by the halted context, or if that context will never reach it anymore.
+    if (m_breakpoint_resume)
+    {
+        auto resume_context = m_breakpoint_resume_context.lock();
+        if (!resume_context || resume_context->empty() || resume_context->terminate())
+        {
+            m_breakpoint_resume = nullptr;
+        }
+        else if (m_breakpoint_resume == &instruction && resume_context == m_context_active)
+        {
+            m_breakpoint_resume = nullptr;
+            return false;
+        }
+    }
+    auto& dinf = instruction.diag_info();
+    auto res = m_breakpoints_by_line.find(dinf.line);
+    if (res == m_breakpoints_by_line.end())
+    {
+        return false;
+    }
+    // Copied as evaluating a condition may alter the breakpoints.
+    auto indices = res->second;
+    for (auto index : indices)
+    {
+        if (index >= m_breakpoints.size())
+        {
+            continue;
+        }
+        auto breakpoint = m_breakpoints[index];
+        if (breakpoint.is_enabled() && breakpoint.file() == dinf.path().physical && (breakpoint.condition().empty() || breakpoint_condition(breakpoint)))
+        {
+            breakpoint_hit(breakpoint);
+            m_breakpoint_resume = &instruction;
+            m_breakpoint_resume_context = m_context_active;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool sqf::runtime::runtime::breakpoint_condition(const sqf::runtime::diagnostics::breakpoint& breakpoint)
+{
+    auto set = parse_sqf_cached(std::string(breakpoint.condition()), { std::string("__breakpoint_condition__.sqf"), {} });
+    if (!set.has_value())
+    { // Halt on broken conditions, so that they do not go unnoticed.
+        return true;
+    }
+
+    // The condition runs in a context of its own, so that neither the value stack, the frames nor the
+    // error handling of the halted context are touched by it. Variables of the halted context are read in place.
+    // Note that only assignments are kept away from the halted context. Arrays are shared, hence eg. pushBack
+    // in a condition changes the live data.
+    auto condition_context = std::make_shared<sqf::runtime::context>();
+    condition_context->variables_fallback(m_context_active.get());
+    condition_context->push_frame({ default_value_scope(), *set });
+
+    auto old_active = m_context_active;
+    m_context_active = condition_context;
+    auto res = result::ok;
+    while (res == result::ok && !condition_context->empty())
+    {
+        res = execute_do(*this, 1);
+    }
+    m_context_active = old_active;
+
+    if (res == result::runtime_error)
+    {
+        return true;
+    }
+    auto value = condition_context->pop_value(true);
+    return !value.has_value() || !value->is<sqf::runtime::t_boolean>() || value->data<sqf::types::d_boolean, bool>();
+}
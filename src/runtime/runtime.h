@@ -1,6 +1,7 @@
 #pragma once
 #include "logging.h"
 #include "diagnostics/breakpoint.h"
+#include "diagnostics/profiler.h"
 #include "context.h"
 #include "confighost.h"
 #include "fileio.h"
@@ -9,12 +10,19 @@
 #include "parser/preprocessor.h"
 #include "value_scope.h"
 #include "sqfop.h"
+#include "sqfop_set.h"
+#include "compile_cache.h"
+#include "d_scalar.h"
 
 #include <chrono>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include <vector>
+#include <unordered_map>
 #include <typeinfo>
 #include <typeindex>
+#include <stdexcept>
 
 namespace sqf::runtime
 {
@@ -85,28 +93,66 @@ namespace sqf::runtime
             /// </summary>
             bool print_context_work_to_log_on_exit;
 
+            /// <summary>
+            /// If true, parsed SQF gets optimized prior to execution.
+            /// Pure operators with literal operands get folded and constant arrays get pre-built.
+            /// </summary>
+            bool enable_optimizer;
+
+            /// <summary>
+            /// Maximum amount of bytes (approximated) the compile cache may occupy.
+            /// Disables the compile cache if 0.
+            /// </summary>
+            size_t compile_cache_capacity;
+
+            /// <summary>
+            /// Maximum amount of instructions a single context may execute before getting terminated.
+            /// Ignored if 0.
+            /// </summary>
+            size_t max_context_instructions;
 
             runtime_conf() :
                 max_runtime(std::chrono::milliseconds::zero()),
                 disable_sleep(false),
                 enable_classname_check(true),
                 disable_networking(false),
-                print_context_work_to_log_on_exit(false)
+                print_context_work_to_log_on_exit(false),
+                enable_optimizer(false),
+                compile_cache_capacity(64 * 1024 * 1024),
+                max_context_instructions(0)
             {}
         };
 
 #pragma region Runtime state handling
 
     private:
-        bool m_is_halt_requested;
-        bool m_is_exit_requested;
-        state m_state;
+        // Written by the interactive and debugger threads while the VM thread is running or idling.
+        std::atomic<bool> m_is_halt_requested;
+        std::atomic<bool> m_is_exit_requested;
+        std::atomic<state> m_state;
         int m_exit_code;
         std::atomic<bool> m_run_atomic;
 
+        std::mutex m_idle_mutex;
+        std::condition_variable m_idle_condition;
+
+        /// <summary>
+        /// Blocks the calling thread until the provided timestamp got reached
+        /// or wakeup() was called due to an exit or evaluate request.
+        /// </summary>
+        void idle_until(std::chrono::system_clock::time_point timestamp);
+
     public:
+        /// <summary>
+        /// Interrupts an idling scheduler, waiting for suspended contexts to wake up.
+        /// </summary>
+        void wakeup()
+        {
+            std::lock_guard<std::mutex> lock(m_idle_mutex);
+            m_idle_condition.notify_all();
+        }
         bool is_exit_requested() const { return m_is_exit_requested; }
-        void exit(int exit_code) { m_exit_code = exit_code; m_is_exit_requested = true; }
+        void exit(int exit_code) { m_exit_code = exit_code; m_is_exit_requested = true; wakeup(); }
         std::optional<int> exit_code() const { return m_is_exit_requested ? m_exit_code : std::optional<int>(); }
         state runtime_state() const { return m_state; }
 
@@ -115,20 +161,55 @@ namespace sqf::runtime
 
     private:
         std::vector<sqf::runtime::diagnostics::breakpoint> m_breakpoints;
+        // Line to the indices of all breakpoints in m_breakpoints at that line.
+        std::unordered_map<size_t, std::vector<size_t>> m_breakpoints_by_line;
         sqf::runtime::diagnostics::breakpoint m_last_breakpoint_hit;
+        // The instruction execution got halted at last, skipped once when execution continues.
+        const sqf::runtime::instruction* m_breakpoint_resume;
+        // The context m_breakpoint_resume belongs to. The marker is dropped once it is gone, empty or terminated.
+        std::weak_ptr<sqf::runtime::context> m_breakpoint_resume_context;
+
+        void breakpoints_reindex()
+        {
+            m_breakpoints_by_line.clear();
+            for (size_t i = 0; i < m_breakpoints.size(); i++)
+            {
+                m_breakpoints_by_line[m_breakpoints[i].line()].push_back(i);
+            }
+        }
+        bool breakpoint_condition(const sqf::runtime::diagnostics::breakpoint& breakpoint);
     public:
-        using breakpoints_iterator = std::vector<sqf::runtime::diagnostics::breakpoint>::iterator;
+        using breakpoints_iterator = std::vector<sqf::runtime::diagnostics::breakpoint>::const_iterator;
         const std::vector<sqf::runtime::diagnostics::breakpoint>& breakpoints() const { return m_breakpoints; }
-        std::vector<sqf::runtime::diagnostics::breakpoint>& breakpoints() { return m_breakpoints; }
 
-        breakpoints_iterator breakpoints_begin() { return m_breakpoints.begin(); }
-        breakpoints_iterator breakpoints_end() { return m_breakpoints.end(); }
-        void erase(breakpoints_iterator from, breakpoints_iterator to) { m_breakpoints.erase(from, to); }
-        void erase(breakpoints_iterator iterator) { m_breakpoints.erase(iterator); }
-        void push_back(sqf::runtime::diagnostics::breakpoint bp) { m_breakpoints.push_back(bp); }
+        breakpoints_iterator breakpoints_begin() const { return m_breakpoints.begin(); }
+        breakpoints_iterator breakpoints_end() const { return m_breakpoints.end(); }
+        void erase(breakpoints_iterator from, breakpoints_iterator to) { m_breakpoints.erase(from, to); breakpoints_reindex(); }
+        void erase(breakpoints_iterator iterator) { m_breakpoints.erase(iterator); breakpoints_reindex(); }
+        void push_back(sqf::runtime::diagnostics::breakpoint bp) { m_breakpoints.push_back(bp); breakpoints_reindex(); m_breakpoint_resume = nullptr; }
 
         void breakpoint_hit(sqf::runtime::diagnostics::breakpoint breakpoint) { m_last_breakpoint_hit = breakpoint; m_is_halt_requested = true; }
 
+        /// <summary>
+        /// Checks whether an enabled breakpoint, with its condition met, is placed at the provided instruction
+        /// and calls breakpoint_hit if so.
+        /// Only meant to be called if breakpoints are set at all, see breakpoints().
+        /// </summary>
+        /// <param name="instruction">The instruction about to be executed by the active context.</param>
+        /// <returns>True if execution has to halt prior to the provided instruction.</returns>
+        bool breakpoint_check(const sqf::runtime::instruction& instruction);
+
+    private:
+        std::unique_ptr<sqf::runtime::diagnostics::profiler> m_profiler;
+    public:
+        /// <summary>
+        /// Receives the profiler recording every executed instruction.
+        /// </summary>
+        /// <returns>The profiler or nullptr if profiling is disabled.</returns>
+        sqf::runtime::diagnostics::profiler* profiler() { return m_profiler.get(); }
+        void profiler_enable() { if (!m_profiler) { m_profiler = std::make_unique<sqf::runtime::diagnostics::profiler>(); } }
+        void profiler_disable() { m_profiler.reset(); }
+
 #pragma endregion
 #pragma region Storage
 
@@ -165,54 +246,227 @@ namespace sqf::runtime
 #pragma region Operators
 
     private:
-        std::unordered_map<sqf::runtime::sqfop_binary::key, sqf::runtime::sqfop_binary> m_operators_binary;
-        std::unordered_map<std::string, std::vector<sqf::runtime::sqfop_binary::cwref>> m_operators_by_name_binary;
+        // Operators registered on this runtime. Take precedence over m_operators_shared.
+        sqf::runtime::sqfop_set m_operators;
+        std::shared_ptr<const sqf::runtime::sqfop_set> m_operators_shared;
 
-        std::unordered_map<sqf::runtime::sqfop_unary::key, sqf::runtime::sqfop_unary> m_operators_unary;
-        std::unordered_map<std::string, std::vector<sqf::runtime::sqfop_unary::cwref>> m_operators_by_name_unary;
+        std::unordered_map<std::string, std::shared_ptr<const sqf::runtime::sqfop_binary_table>> m_operators_table_binary;
+        std::unordered_map<std::string, std::shared_ptr<const sqf::runtime::sqfop_unary_table>> m_operators_table_unary;
+        // The tables get filled lazily, also by the optimizer while files are parsed concurrently.
+        std::mutex m_operators_table_mutex;
+        size_t m_operators_revision;
 
-        std::unordered_map<sqf::runtime::sqfop_nular::key, sqf::runtime::sqfop_nular> m_operators_nular;
+        static size_t sqfop_revision_next()
+        {
+            static std::atomic<size_t> counter = 0;
+            return ++counter;
+        }
+        void sqfop_invalidate()
+        {
+            std::lock_guard<std::mutex> lock(m_operators_table_mutex);
+            m_operators_table_binary.clear();
+            m_operators_table_unary.clear();
+            m_operators_revision = sqfop_revision_next();
+            m_compile_cache.clear();
+        }
+        template<typename TKey>
+        auto sqfop_find(const TKey& key) const
+        {
+            auto res = m_operators.find(key);
+            return res || !m_operators_shared ? res : m_operators_shared->find(key);
+        }
+        template<typename TOp, typename TMap>
+        std::vector<std::reference_wrapper<const TOp>> sqfop_all(const TMap& (sqf::runtime::sqfop_set::* map)() const) const
+        {
+            std::vector<std::reference_wrapper<const TOp>> ops;
+            for (auto& it : (m_operators.*map)())
+            {
+                ops.push_back(it.second);
+            }
+            if (m_operators_shared)
+            {
+                for (auto& it : ((*m_operators_shared).*map)())
+                {
+                    if (!m_operators.find(it.first))
+                    {
+                        ops.push_back(it.second);
+                    }
+                }
+            }
+            return ops;
+        }
     public:
-        using sqfop_binary_iterator = std::unordered_map<sqf::runtime::sqfop_binary::key, sqf::runtime::sqfop_binary>::const_iterator;
-        using sqfop_unary_iterator = std::unordered_map<sqf::runtime::sqfop_unary::key, sqf::runtime::sqfop_unary>::const_iterator;
-        using sqfop_nular_iterator = std::unordered_map<sqf::runtime::sqfop_nular::key, sqf::runtime::sqfop_nular>::const_iterator;
-
-        sqfop_binary_iterator sqfop_binary_begin() const { return m_operators_binary.begin(); }
-        sqfop_binary_iterator sqfop_binary_end() const { return m_operators_binary.end(); }
-        bool sqfop_exists(const sqf::runtime::sqfop_binary::key key) const { return m_operators_binary.find(key) != m_operators_binary.end(); }
-        sqf::runtime::sqfop_binary::cref sqfop_at(const sqf::runtime::sqfop_binary::key key) const { return m_operators_binary.at(key); }
-        const std::vector<sqf::runtime::sqfop_binary::cwref>& sqfop_binary_by_name(const std::string key) const { return m_operators_by_name_binary.at(key); }
+        /// <summary>
+        /// Returns a process-wide unique number, identifying the current set of registered operators.
+        /// Changes whenever an operator gets registered, allowing instructions to cache pre-resolved operators.
+        /// </summary>
+        size_t sqfop_revision() const { return m_operators_revision; }
+
+        /// <summary>
+        /// Moves all operators registered on this runtime into an immutable set,
+        /// that then can be passed to sqfop_share of other runtimes.
+        /// The runtime itself keeps using the returned set.
+        /// </summary>
+        std::shared_ptr<const sqf::runtime::sqfop_set> sqfop_freeze()
+        {
+            if (!m_operators_shared)
+            {
+                m_operators_shared = std::make_shared<const sqf::runtime::sqfop_set>(std::move(m_operators));
+            }
+            else if (!m_operators.empty())
+            {
+                auto merged = std::make_shared<sqf::runtime::sqfop_set>();
+                for (auto set : std::initializer_list<const sqf::runtime::sqfop_set*>{ m_operators_shared.get(), &m_operators })
+                {
+                    for (auto& it : set->nular()) { merged->insert(it.second); }
+                    for (auto& it : set->unary()) { merged->insert(it.second); }
+                    for (auto& it : set->binary()) { merged->insert(it.second); }
+                }
+                m_operators_shared = merged;
+            }
+            m_operators = {};
+            sqfop_invalidate();
+            return m_operators_shared;
+        }
+
+        /// <summary>
+        /// Makes the operators of the provided immutable set available to this runtime,
+        /// replacing the previously shared set. Operators registered on this runtime are kept
+        /// and take precedence.
+        /// </summary>
+        void sqfop_share(std::shared_ptr<const sqf::runtime::sqfop_set> set)
+        {
+            if (set == m_operators_shared)
+            {
+                return;
+            }
+            // By-name lists of the own operators refer to the previous set and need to be rebuilt.
+            auto own = std::move(m_operators);
+            m_operators = {};
+            m_operators_shared = std::move(set);
+            for (auto& it : own.nular()) { m_operators.insert(it.second, m_operators_shared.get()); }
+            for (auto& it : own.unary()) { m_operators.insert(it.second, m_operators_shared.get()); }
+            for (auto& it : own.binary()) { m_operators.insert(it.second, m_operators_shared.get()); }
+            sqfop_invalidate();
+        }
+
+        /// <summary>
+        /// Receives the pre-resolved overload set of the binary operator with the provided (lowercase) name.
+        /// Tables are shared between all callers until the next operator gets registered.
+        /// </summary>
+        std::shared_ptr<const sqf::runtime::sqfop_binary_table> sqfop_resolve_binary(const std::string& key)
+        {
+            std::lock_guard<std::mutex> lock(m_operators_table_mutex);
+            auto res = m_operators_table_binary.find(key);
+            if (res != m_operators_table_binary.end())
+            {
+                return res->second;
+            }
+            auto ops = sqfop_binary_by_name_or_null(key);
+            auto table = ops == nullptr ?
+                std::make_shared<const sqf::runtime::sqfop_binary_table>(std::vector<sqf::runtime::sqfop_binary::cwref>{}) :
+                std::make_shared<const sqf::runtime::sqfop_binary_table>(*ops);
+            m_operators_table_binary[key] = table;
+            return table;
+        }
+
+        /// <summary>
+        /// Receives the pre-resolved overload set of the unary operator with the provided (lowercase) name.
+        /// Tables are shared between all callers until the next operator gets registered.
+        /// </summary>
+        std::shared_ptr<const sqf::runtime::sqfop_unary_table> sqfop_resolve_unary(const std::string& key)
+        {
+            std::lock_guard<std::mutex> lock(m_operators_table_mutex);
+            auto res = m_operators_table_unary.find(key);
+            if (res != m_operators_table_unary.end())
+            {
+                return res->second;
+            }
+            auto ops = sqfop_unary_by_name_or_null(key);
+            auto table = ops == nullptr ?
+                std::make_shared<const sqf::runtime::sqfop_unary_table>(std::vector<sqf::runtime::sqfop_unary::cwref>{}) :
+                std::make_shared<const sqf::runtime::sqfop_unary_table>(*ops);
+            m_operators_table_unary[key] = table;
+            return table;
+        }
+
+        /// <summary>
+        /// Receives the nular operator with the provided (lowercase) name.
+        /// </summary>
+        /// <returns>The operator or nullptr if it does not exist.</returns>
+        const sqf::runtime::sqfop_nular* sqfop_resolve_nular(const std::string& key) const
+        {
+            return sqfop_find(sqf::runtime::sqfop_nular::key{ key });
+        }
+
+        std::vector<sqf::runtime::sqfop_binary::cwref> sqfop_binary_all() const { return sqfop_all<sqf::runtime::sqfop_binary>(&sqf::runtime::sqfop_set::binary); }
+        bool sqfop_exists(const sqf::runtime::sqfop_binary::key key) const { return sqfop_find(key) != nullptr; }
+        sqf::runtime::sqfop_binary::cref sqfop_at(const sqf::runtime::sqfop_binary::key key) const
+        {
+            auto res = sqfop_find(key);
+            if (!res) { throw std::out_of_range("sqfop_at"); }
+            return *res;
+        }
+        const std::vector<sqf::runtime::sqfop_binary::cwref>* sqfop_binary_by_name_or_null(const std::string& key) const
+        {
+            auto res = m_operators.binary_by_name(key);
+            return res || !m_operators_shared ? res : m_operators_shared->binary_by_name(key);
+        }
+        const std::vector<sqf::runtime::sqfop_binary::cwref>& sqfop_binary_by_name(const std::string key) const
+        {
+            auto res = sqfop_binary_by_name_or_null(key);
+            if (!res) { throw std::out_of_range("sqfop_binary_by_name"); }
+            return *res;
+        }
         bool sqfop_exists_binary(std::string key) const
         {
             std::transform(key.begin(), key.end(), key.begin(), [](char& c) { return (char)std::tolower((int)c); });
-            return m_operators_by_name_binary.find(key) != m_operators_by_name_binary.end();
+            return sqfop_binary_by_name_or_null(key) != nullptr;
         }
         void register_sqfop(sqf::runtime::sqfop_binary op)
         {
-            m_operators_binary.insert({ op.get_key(), op });
-            m_operators_by_name_binary[std::string(op.name())].push_back(m_operators_binary[op.get_key()]);
+            m_operators.insert(std::move(op), m_operators_shared.get());
+            sqfop_invalidate();
         }
 
-        sqfop_unary_iterator sqfop_unary_begin() const { return m_operators_unary.begin(); }
-        sqfop_unary_iterator sqfop_unary_end() const { return m_operators_unary.end(); }
-        bool sqfop_exists(const sqf::runtime::sqfop_unary::key key) const { return m_operators_unary.find(key) != m_operators_unary.end(); }
-        sqf::runtime::sqfop_unary::cref sqfop_at(const sqf::runtime::sqfop_unary::key key) const { return m_operators_unary.at(key); }
-        const std::vector<sqf::runtime::sqfop_unary::cwref>& sqfop_unary_by_name(const std::string key) const { return m_operators_by_name_unary.at(key); }
+        std::vector<sqf::runtime::sqfop_unary::cwref> sqfop_unary_all() const { return sqfop_all<sqf::runtime::sqfop_unary>(&sqf::runtime::sqfop_set::unary); }
+        bool sqfop_exists(const sqf::runtime::sqfop_unary::key key) const { return sqfop_find(key) != nullptr; }
+        sqf::runtime::sqfop_unary::cref sqfop_at(const sqf::runtime::sqfop_unary::key key) const
+        {
+            auto res = sqfop_find(key);
+            if (!res) { throw std::out_of_range("sqfop_at"); }
+            return *res;
+        }
+        const std::vector<sqf::runtime::sqfop_unary::cwref>* sqfop_unary_by_name_or_null(const std::string& key) const
+        {
+            auto res = m_operators.unary_by_name(key);
+            return res || !m_operators_shared ? res : m_operators_shared->unary_by_name(key);
+        }
+        const std::vector<sqf::runtime::sqfop_unary::cwref>& sqfop_unary_by_name(const std::string key) const
+        {
+            auto res = sqfop_unary_by_name_or_null(key);
+            if (!res) { throw std::out_of_range("sqfop_unary_by_name"); }
+            return *res;
+        }
         bool sqfop_exists_unary(std::string key) const
         {
             std::transform(key.begin(), key.end(), key.begin(), [](char& c) { return (char)std::tolower((int)c); }); 
-            return m_operators_by_name_unary.find(key) != m_operators_by_name_unary.end();
+            return sqfop_unary_by_name_or_null(key) != nullptr;
         }
         void register_sqfop(sqf::runtime::sqfop_unary op)
         {
-            m_operators_unary.insert({ op.get_key(), op });
-            m_operators_by_name_unary[std::string(op.name())].push_back(m_operators_unary[op.get_key()]);
+            m_operators.insert(std::move(op), m_operators_shared.get());
+            sqfop_invalidate();
         }
 
-        sqfop_nular_iterator sqfop_nular_begin() const { return m_operators_nular.begin(); }
-        sqfop_nular_iterator sqfop_nular_end() const { return m_operators_nular.end(); }
-        bool sqfop_exists(const sqf::runtime::sqfop_nular::key key) const { return m_operators_nular.find(key) != m_operators_nular.end(); }
-        sqf::runtime::sqfop_nular::cref sqfop_at(const sqf::runtime::sqfop_nular::key key) const { return m_operators_nular.at(key); }
+        std::vector<sqf::runtime::sqfop_nular::cwref> sqfop_nular_all() const { return sqfop_all<sqf::runtime::sqfop_nular>(&sqf::runtime::sqfop_set::nular); }
+        bool sqfop_exists(const sqf::runtime::sqfop_nular::key key) const { return sqfop_find(key) != nullptr; }
+        sqf::runtime::sqfop_nular::cref sqfop_at(const sqf::runtime::sqfop_nular::key key) const
+        {
+            auto res = sqfop_find(key);
+            if (!res) { throw std::out_of_range("sqfop_at"); }
+            return *res;
+        }
         bool sqfop_exists_nular(std::string key) const
         {
             std::transform(key.begin(), key.end(), key.begin(), [](char& c) { return (char)std::tolower((int)c); });
@@ -220,7 +474,8 @@ namespace sqf::runtime
         }
         void register_sqfop(sqf::runtime::sqfop_nular op)
         {
-            m_operators_nular.insert({ op.get_key(), op });
+            m_operators.insert(std::move(op), m_operators_shared.get());
+            sqfop_invalidate();
         }
 
 #pragma endregion
@@ -251,7 +506,9 @@ namespace sqf::runtime
 #pragma region Code Evaluation
 
         private:
-            bool m_evaluate_halt;
+            std::atomic<bool> m_evaluate_halt;
+            // Serializes evaluate_expression, as files may get preprocessed (and thus __EVAL'd) from multiple threads.
+            std::mutex m_evaluate_mutex;
 
             void perform_evaluate()
             {
@@ -275,6 +532,7 @@ namespace sqf::runtime
             /// A deadlock will happen, if this operation is occuring from within an operator due
             /// to the evaluate expression then waiting for the operator to finish that called
             /// the evaluate method.
+            /// Concurrent calls are safe and get executed one after another.
             /// </remarks>
             /// <param name="view">The contents to parse.</param>
             /// <param name="success">Wether the operation was successful or something moved wrong.</param>
@@ -298,7 +556,13 @@ namespace sqf::runtime
                     else  { m_context_active = m_contexts.front(); return *m_context_active; }
                 };
                 std::shared_ptr<sqf::runtime::context> context_active_as_shared() const { return m_context_active; };
-                std::weak_ptr<context> context_create() { auto ptr = std::make_shared<context>(); m_contexts.push_back(ptr); return ptr; }
+                std::weak_ptr<context> context_create()
+                {
+                    auto ptr = std::make_shared<context>();
+                    ptr->instruction_budget(m_configuration.max_context_instructions);
+                    m_contexts.push_back(ptr);
+                    return ptr;
+                }
                 context_iterator context_begin() { return m_contexts.begin(); }
                 context_iterator context_end() { return m_contexts.end(); }
 
@@ -309,16 +573,24 @@ namespace sqf::runtime
     private:
         runtime_conf m_configuration;
         std::chrono::system_clock::time_point m_runtime_timestamp;
+        std::chrono::steady_clock::time_point m_runtime_steady_timestamp;
+        size_t m_runtime_watchdog_countdown;
         bool m_runtime_error;
 
+        // Amount of instructions executed between two clock reads for max_runtime.
+        // The limit hence gets detected up to runtime_watchdog_interval - 1 instructions late.
+        static constexpr size_t runtime_watchdog_interval = 1024;
+
         std::chrono::system_clock::time_point m_created_timestamp;
         std::chrono::system_clock::time_point m_current_time;
+        int m_scalar_decimals;
         sqf::runtime::confighost m_confighost;
 
         std::unique_ptr<sqf::runtime::fileio> m_fileio;
         std::unique_ptr<sqf::runtime::parser::sqf> m_parser_sqf;
         std::unique_ptr<sqf::runtime::parser::config> m_parser_config;
         std::unique_ptr<sqf::runtime::parser::preprocessor> m_parser_preprocessor;
+        sqf::runtime::compile_cache m_compile_cache;
 
     public:
         runtime(Logger& logger, runtime_conf config) :
@@ -330,17 +602,24 @@ namespace sqf::runtime
             m_run_atomic(false),
             m_breakpoints(),
             m_last_breakpoint_hit(~((size_t)0), {}),
+            m_breakpoint_resume(nullptr),
+            m_breakpoint_resume_context(),
+            m_operators_revision(sqfop_revision_next()),
             m_default_scope_key("default"),
             m_evaluate_halt(false),
             m_configuration(config),
             m_runtime_timestamp(std::chrono::system_clock::now()),
+            m_runtime_steady_timestamp(std::chrono::steady_clock::now()),
+            m_runtime_watchdog_countdown(runtime_watchdog_interval),
             m_runtime_error(false),
             m_created_timestamp(m_runtime_timestamp),
+            m_scalar_decimals(-1),
             m_confighost(),
             m_fileio(std::make_unique<sqf::fileio::disabled>()),
             m_parser_sqf(std::make_unique<sqf::parser::sqf::disabled>()),
             m_parser_config(std::make_unique<sqf::parser::config::disabled>()),
-            m_parser_preprocessor(std::make_unique<sqf::parser::preprocessor::passthrough>())
+            m_parser_preprocessor(std::make_unique<sqf::parser::preprocessor::passthrough>()),
+            m_compile_cache(config.compile_cache_capacity)
         {
         }
 
@@ -348,7 +627,27 @@ namespace sqf::runtime
         sqf::runtime::runtime::result execute(sqf::runtime::runtime::action action);
         sqf::runtime::runtime::runtime_conf& configuration() { return m_configuration; }
         std::chrono::system_clock::time_point runtime_timestamp() { return m_runtime_timestamp; }
-        void runtime_timestamp_reset() { m_runtime_timestamp = std::chrono::system_clock::now(); }
+        void runtime_timestamp_reset()
+        {
+            m_runtime_timestamp = std::chrono::system_clock::now();
+            m_runtime_steady_timestamp = std::chrono::steady_clock::now();
+            m_runtime_watchdog_countdown = runtime_watchdog_interval;
+        }
+
+        /// <summary>
+        /// Checks whether configuration().max_runtime got exceeded since the last runtime_timestamp_reset().
+        /// Expected to be called once per instruction. The clock only gets read every runtime_watchdog_interval instructions,
+        /// hence up to runtime_watchdog_interval - 1 (1023) instructions may execute after the limit got exceeded.
+        /// </summary>
+        bool max_runtime_reached()
+        {
+            if (--m_runtime_watchdog_countdown != 0)
+            {
+                return false;
+            }
+            m_runtime_watchdog_countdown = runtime_watchdog_interval;
+            return std::chrono::steady_clock::now() - m_runtime_steady_timestamp > m_configuration.max_runtime;
+        }
 
         sqf::runtime::confighost& confighost() { return m_confighost; }
 
@@ -360,6 +659,27 @@ namespace sqf::runtime
         sqf::runtime::parser::sqf& parser_sqf() { return *m_parser_sqf; }
         sqf::runtime::parser::config& parser_config() { return *m_parser_config; }
         sqf::runtime::parser::preprocessor& parser_preprocessor() { return *m_parser_preprocessor; }
+        sqf::runtime::compile_cache& compile_cache() { return m_compile_cache; }
+
+        /// <summary>
+        /// The amount of decimals SCALAR values get formatted with (as set by toFixed), -1 for the default format.
+        /// </summary>
+        int scalar_decimals() const { return m_scalar_decimals; }
+        void scalar_decimals(int decimals) { m_scalar_decimals = decimals; }
+        /// <summary>
+        /// Makes SCALAR values formatted on the calling thread use scalar_decimals() of this runtime,
+        /// until the returned scope is destroyed. Taken by execute and evaluate_expression.
+        /// </summary>
+        sqf::types::d_scalar::decimals_scope scalar_format_scope() const { return { m_scalar_decimals }; }
+
+        /// <summary>
+        /// Parses the provided SQF contents using parser_sqf(), reusing the instruction_set
+        /// of a previous call with equal contents and file if it is still held by the compile cache.
+        /// </summary>
+        /// <param name="contents">The preprocessed SQF to parse.</param>
+        /// <param name="file">The file the contents originate from.</param>
+        /// <returns>The parsed instruction_set or an empty optional if parsing failed.</returns>
+        std::optional<sqf::runtime::instruction_set> parse_sqf_cached(std::string contents, sqf::runtime::fileio::pathinfo file);
 
 
     public:
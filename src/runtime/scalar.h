@@ -0,0 +1,15 @@
+#pragma once
+
+namespace sqf::runtime
+{
+    /// <summary>
+    /// The native type SCALAR values are stored and calculated with.
+    /// float by default, matching the engine. Defining DF__SQF_RUNTIME__SCALAR_DOUBLE
+    /// (CMake option SQFVM_DOUBLE_SCALAR) switches to double precision.
+    /// </summary>
+#ifdef DF__SQF_RUNTIME__SCALAR_DOUBLE
+    using scalar_t = double;
+#else
+    using scalar_t = float;
+#endif // DF__SQF_RUNTIME__SCALAR_DOUBLE
+}
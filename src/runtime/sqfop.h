@@ -5,6 +5,9 @@
 #include <string>
 #include <string_view>
 #include <functional>
+#include <vector>
+#include <algorithm>
+#include <cctype>
 
 namespace sqf::runtime
 {
@@ -100,6 +103,135 @@ namespace sqf::runtime
         value execute(sqf::runtime::runtime& vm) const { return m_callback(vm); }
         key get_key() const { return m_key; }
     };
+
+    /// <summary>
+    /// Pre-resolved overload set of a single binary operator name.
+    /// Maps the type ids of both operands directly to the operator to execute,
+    /// following the same fallback order as a keyed lookup would (exact, ANY/right, left/ANY, ANY/ANY).
+    /// </summary>
+    class sqfop_binary_table
+    {
+    private:
+        std::vector<const sqfop_binary*> m_overloads;
+        std::vector<unsigned short> m_lookup;
+        unsigned short m_types;
+
+        unsigned short resolve(unsigned short left, unsigned short right) const
+        {
+            unsigned short any = sqf::types::t_any();
+            unsigned short best = 0;
+            int best_rank = 4;
+            for (unsigned short i = 1; i < m_overloads.size(); i++)
+            {
+                unsigned short l = m_overloads[i]->left_type();
+                unsigned short r = m_overloads[i]->right_type();
+                int rank;
+                if (l == left && r == right) { rank = 0; }
+                else if (l == any && r == right) { rank = 1; }
+                else if (l == left && r == any) { rank = 2; }
+                else if (l == any && r == any) { rank = 3; }
+                else { continue; }
+                if (rank < best_rank)
+                {
+                    best = i;
+                    best_rank = rank;
+                }
+            }
+            return best;
+        }
+    public:
+        sqfop_binary_table(const std::vector<sqfop_binary::cwref>& overloads) :
+            m_types(sqf::runtime::type::count())
+        {
+            m_overloads.reserve(overloads.size() + 1);
+            m_overloads.push_back(nullptr);
+            for (auto& it : overloads)
+            {
+                m_overloads.push_back(&it.get());
+            }
+            m_lookup.resize((size_t)m_types * m_types);
+            for (unsigned short l = 0; l < m_types; l++)
+            {
+                for (unsigned short r = 0; r < m_types; r++)
+                {
+                    m_lookup[(size_t)l * m_types + r] = resolve(l, r);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Receives the operator to execute for the provided operand types.
+        /// </summary>
+        /// <returns>The operator or nullptr if no overload accepts the type combination.</returns>
+        const sqfop_binary* at(sqf::runtime::type left, sqf::runtime::type right) const
+        {
+            unsigned short l = left;
+            unsigned short r = right;
+            if (l < m_types && r < m_types)
+            {
+                return m_overloads[m_lookup[(size_t)l * m_types + r]];
+            }
+            // Type got registered after this table was built.
+            return m_overloads[resolve(l, r)];
+        }
+    };
+
+    /// <summary>
+    /// Pre-resolved overload set of a single unary operator name.
+    /// Maps the type id of the operand directly to the operator to execute,
+    /// falling back to the ANY overload if no exact match exists.
+    /// </summary>
+    class sqfop_unary_table
+    {
+    private:
+        std::vector<const sqfop_unary*> m_overloads;
+        std::vector<unsigned short> m_lookup;
+        unsigned short m_types;
+
+        unsigned short resolve(unsigned short right) const
+        {
+            unsigned short any = sqf::types::t_any();
+            unsigned short fallback = 0;
+            for (unsigned short i = 1; i < m_overloads.size(); i++)
+            {
+                unsigned short r = m_overloads[i]->right_type();
+                if (r == right) { return i; }
+                else if (r == any) { fallback = i; }
+            }
+            return fallback;
+        }
+    public:
+        sqfop_unary_table(const std::vector<sqfop_unary::cwref>& overloads) :
+            m_types(sqf::runtime::type::count())
+        {
+            m_overloads.reserve(overloads.size() + 1);
+            m_overloads.push_back(nullptr);
+            for (auto& it : overloads)
+            {
+                m_overloads.push_back(&it.get());
+            }
+            m_lookup.resize(m_types);
+            for (unsigned short r = 0; r < m_types; r++)
+            {
+                m_lookup[r] = resolve(r);
+            }
+        }
+
+        /// <summary>
+        /// Receives the operator to execute for the provided operand type.
+        /// </summary>
+        /// <returns>The operator or nullptr if no overload accepts the type.</returns>
+        const sqfop_unary* at(sqf::runtime::type right) const
+        {
+            unsigned short r = right;
+            if (r < m_types)
+            {
+                return m_overloads[m_lookup[r]];
+            }
+            // Type got registered after this table was built.
+            return m_overloads[resolve(r)];
+        }
+    };
     namespace sqfop
     {
         /// <summary>
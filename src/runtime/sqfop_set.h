@@ -0,0 +1,122 @@
+#pragma once
+#include "sqfop.h"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace sqf::runtime
+{
+    /// <summary>
+    /// Collection of operators, indexed by key and by name.
+    /// A runtime keeps its own, usually small set for operators registered on it
+    /// and may share a frozen set with other runtimes (see runtime::sqfop_freeze).
+    /// Once shared via std::shared_ptr&lt;const sqfop_set&gt;, a set is never modified again.
+    /// </summary>
+    class sqfop_set
+    {
+    public:
+        using binary_map = std::unordered_map<sqfop_binary::key, sqfop_binary>;
+        using unary_map = std::unordered_map<sqfop_unary::key, sqfop_unary>;
+        using nular_map = std::unordered_map<sqfop_nular::key, sqfop_nular>;
+    private:
+        // Node based, references handed out into the by-name lists stay valid, even if the set gets moved.
+        binary_map m_binary;
+        std::unordered_map<std::string, std::vector<sqfop_binary::cwref>> m_binary_by_name;
+        unary_map m_unary;
+        std::unordered_map<std::string, std::vector<sqfop_unary::cwref>> m_unary_by_name;
+        nular_map m_nular;
+
+        template<typename TMap>
+        static const typename TMap::mapped_type* find_in(const TMap& map, const typename TMap::key_type& key)
+        {
+            auto res = map.find(key);
+            return res == map.end() ? nullptr : &res->second;
+        }
+    public:
+        const binary_map& binary() const { return m_binary; }
+        const unary_map& unary() const { return m_unary; }
+        const nular_map& nular() const { return m_nular; }
+        bool empty() const { return m_binary.empty() && m_unary.empty() && m_nular.empty(); }
+
+        const sqfop_binary* find(const sqfop_binary::key& key) const { return find_in(m_binary, key); }
+        const sqfop_unary* find(const sqfop_unary::key& key) const { return find_in(m_unary, key); }
+        const sqfop_nular* find(const sqfop_nular::key& key) const { return find_in(m_nular, key); }
+
+        /// <summary>
+        /// Receives all binary operators with the provided (lowercase) name.
+        /// </summary>
+        /// <returns>The overloads or nullptr if no operator with that name exists.</returns>
+        const std::vector<sqfop_binary::cwref>* binary_by_name(const std::string& name) const { return find_in(m_binary_by_name, name); }
+
+        /// <summary>
+        /// Receives all unary operators with the provided (lowercase) name.
+        /// </summary>
+        /// <returns>The overloads or nullptr if no operator with that name exists.</returns>
+        const std::vector<sqfop_unary::cwref>* unary_by_name(const std::string& name) const { return find_in(m_unary_by_name, name); }
+
+        /// <summary>
+        /// Adds the provided operator, unless an operator with the same key exists already,
+        /// either in this set or in base. If base has operators with the same name,
+        /// they get carried over into the by-name list of this set.
+        /// </summary>
+        /// <returns>Wether the operator got added.</returns>
+        bool insert(sqfop_binary op, const sqfop_set* base = nullptr)
+        {
+            auto key = op.get_key();
+            if ((base && base->find(key)) || find(key))
+            {
+                return false;
+            }
+            auto& inserted = m_binary.emplace(key, std::move(op)).first->second;
+            auto by_name = m_binary_by_name.find(key.name);
+            if (by_name == m_binary_by_name.end())
+            {
+                auto base_by_name = base ? base->binary_by_name(key.name) : nullptr;
+                by_name = m_binary_by_name.emplace(key.name, base_by_name ? *base_by_name : std::vector<sqfop_binary::cwref>{}).first;
+            }
+            by_name->second.push_back(inserted);
+            return true;
+        }
+
+        /// <summary>
+        /// Adds the provided operator, unless an operator with the same key exists already,
+        /// either in this set or in base. If base has operators with the same name,
+        /// they get carried over into the by-name list of this set.
+        /// </summary>
+        /// <returns>Wether the operator got added.</returns>
+        bool insert(sqfop_unary op, const sqfop_set* base = nullptr)
+        {
+            auto key = op.get_key();
+            if ((base && base->find(key)) || find(key))
+            {
+                return false;
+            }
+            auto& inserted = m_unary.emplace(key, std::move(op)).first->second;
+            auto by_name = m_unary_by_name.find(key.name);
+            if (by_name == m_unary_by_name.end())
+            {
+                auto base_by_name = base ? base->unary_by_name(key.name) : nullptr;
+                by_name = m_unary_by_name.emplace(key.name, base_by_name ? *base_by_name : std::vector<sqfop_unary::cwref>{}).first;
+            }
+            by_name->second.push_back(inserted);
+            return true;
+        }
+
+        /// <summary>
+        /// Adds the provided operator, unless an operator with the same key exists already,
+        /// either in this set or in base.
+        /// </summary>
+        /// <returns>Wether the operator got added.</returns>
+        bool insert(sqfop_nular op, const sqfop_set* base = nullptr)
+        {
+            auto key = op.get_key();
+            if ((base && base->find(key)) || find(key))
+            {
+                return false;
+            }
+            m_nular.emplace(key, std::move(op));
+            return true;
+        }
+    };
+}
@@ -0,0 +1,52 @@
+#include "symbol.h"
+
+#include <unordered_set>
+#include <mutex>
+#include <cctype>
+#include <algorithm>
+
+namespace
+{
+    // Node based, references to the contained strings stay valid forever.
+    std::unordered_set<std::string>& symbol_table()
+    {
+        static std::unordered_set<std::string> table;
+        return table;
+    }
+    std::mutex& symbol_table_mutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+    std::string to_lower(std::string_view name)
+    {
+        std::string lower(name);
+        std::transform(lower.begin(), lower.end(), lower.begin(), [](char& c) { return (char)std::tolower((int)c); });
+        return lower;
+    }
+}
+
+sqf::runtime::symbol::symbol(std::string lower, bool intern) :
+    m_interned(nullptr),
+    m_transient(),
+    m_hash(std::hash<std::string_view>{}(lower))
+{
+    if (intern)
+    {
+        std::lock_guard<std::mutex> lock(symbol_table_mutex());
+        m_interned = &*symbol_table().insert(std::move(lower)).first;
+    }
+    else
+    {
+        m_transient = std::move(lower);
+    }
+}
+
+sqf::runtime::symbol::symbol(std::string_view name) : symbol(to_lower(name), true)
+{
+}
+
+sqf::runtime::symbol sqf::runtime::symbol::transient(std::string_view name)
+{
+    return symbol(to_lower(name), false);
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <functional>
+
+namespace sqf::runtime
+{
+    /// <summary>
+    /// Lowercase identifier.
+    /// Identifiers known at parse time are interned, hence exist exactly once in the global symbol table
+    /// and are compared by identity instead of by content.
+    /// Names only known at runtime (eg. setVariable) are transient: they carry their own copy
+    /// and never enter the symbol table, so it cannot grow with the data a script creates.
+    /// </summary>
+    class symbol
+    {
+    private:
+        // The interned name or nullptr for transient symbols.
+        const std::string* m_interned;
+        // The name of transient symbols.
+        std::string m_transient;
+        // Content based, so that containers keyed by symbols iterate in the same order on every run.
+        size_t m_hash;
+
+        symbol(std::string lower, bool intern);
+        static const std::string* empty_name() { static const std::string* name = symbol(std::string{}, true).m_interned; return name; }
+    public:
+        /// <summary>
+        /// Creates the empty symbol.
+        /// </summary>
+        symbol() : m_interned(empty_name()), m_transient(), m_hash(std::hash<std::string_view>{}({})) {}
+
+        /// <summary>
+        /// Receives the interned symbol for the provided name, adding it to the symbol table if not yet existing.
+        /// The name is matched case-insensitive.
+        /// Meant for identifiers of parsed code only.
+        /// </summary>
+        explicit symbol(std::string_view name);
+
+        /// <summary>
+        /// Creates a symbol for the provided name without touching the symbol table.
+        /// The name is matched case-insensitive.
+        /// Meant for names created at runtime.
+        /// </summary>
+        static symbol transient(std::string_view name);
+
+        /// <summary>
+        /// The lowercase name of this symbol.
+        /// </summary>
+        const std::string& name() const { return m_interned ? *m_interned : m_transient; }
+        bool empty() const { return name().empty(); }
+        size_t hash() const { return m_hash; }
+        bool operator==(const symbol& other) const
+        {
+            if (m_interned && other.m_interned) { return m_interned == other.m_interned; }
+            return m_hash == other.m_hash && name() == other.name();
+        }
+        bool operator!=(const symbol& other) const { return !(*this == other); }
+    };
+}
+
+template<> struct std::hash<sqf::runtime::symbol> {
+    std::size_t operator()(sqf::runtime::symbol const& s) const noexcept {
+        return s.hash();
+    }
+};
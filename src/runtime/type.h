@@ -3,6 +3,8 @@
 #include <string_view>
 #include <unordered_map>
 #include <functional>
+#include <atomic>
+#include <mutex>
 
 
 
@@ -29,7 +31,12 @@ namespace sqf
         {
         protected:
             unsigned short m_value;
-            static inline unsigned short s_type_value = 0;
+            static inline std::atomic<unsigned short> s_type_value = 0;
+            static std::mutex& registry_mutex()
+            {
+                static std::mutex mutex;
+                return mutex;
+            }
             static std::unordered_map<std::string, type>& typemap_nc()
             {
                 static std::unordered_map<std::string, type> map = std::unordered_map<std::string, type>();
@@ -40,6 +47,20 @@ namespace sqf
                 static std::unordered_map<unsigned short, std::string> map = std::unordered_map<unsigned short, std::string>();
                 return map;
             }
+            /// <summary>
+            /// Hands out the next type id and registers the provided name for it.
+            /// Safe to be called concurrently, allowing runtimes on different threads
+            /// to use a type for the first time at once.
+            /// </summary>
+            static unsigned short register_type(const std::string& name)
+            {
+                std::lock_guard<std::mutex> lock(registry_mutex());
+                type t;
+                t.m_value = ++s_type_value;
+                typemap_nc()[name] = t;
+                namemap_nc()[t] = name;
+                return t.m_value;
+            }
         public:
             template<typename T>
             class extend;
@@ -78,26 +99,27 @@ namespace sqf
                 auto& map = namemap_nc();
                 return map;
             }
+
+            /// <summary>
+            /// Returns the upper bound (exclusive) of all type ids handed out so far.
+            /// Usable to size lookup tables indexed by type.
+            /// </summary>
+            static unsigned short count() { return s_type_value + 1; }
         };
         template<typename T>
         class type::extend : public type
         {
         private:
-            static inline unsigned short s_local_type_value = 0;
+            static unsigned short local_type_value()
+            {
+                // Initialized exactly once, even if the first instances get created concurrently.
+                static const unsigned short value = register_type(T::name());
+                return value;
+            }
         public:
             extend() : type()
             {
-                if (s_local_type_value == 0)
-                {
-                    s_local_type_value = ++s_type_value;
-                    m_value = s_local_type_value;
-                    typemap_nc()[T::name()] = *this;
-                    namemap_nc()[*this] = T::name();
-                }
-                else
-                {
-                    m_value = s_local_type_value;
-                }
+                m_value = local_type_value();
             }
         };
     }
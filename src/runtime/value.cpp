@@ -0,0 +1,53 @@
+#include "value.h"
+#include "d_scalar.h"
+#include "d_boolean.h"
+
+std::shared_ptr<sqf::runtime::data> sqf::runtime::value::box() const
+{
+    switch (m_storage)
+    {
+    case storage::scalar: return sqf::runtime::make_pooled<sqf::types::d_scalar>(m_scalar);
+    case storage::boolean: return sqf::runtime::make_pooled<sqf::types::d_boolean>(m_boolean);
+    default: return {};
+    }
+}
+
+void sqf::runtime::value::adopt(std::shared_ptr<sqf::runtime::data> d)
+{
+    auto t = d->type();
+    if (t == t_scalar())
+    {
+        m_scalar = std::static_pointer_cast<sqf::types::d_scalar>(d)->value();
+        m_storage = storage::scalar;
+    }
+    else if (t == t_boolean())
+    {
+        m_boolean = std::static_pointer_cast<sqf::types::d_boolean>(d)->value();
+        m_storage = storage::boolean;
+    }
+    else
+    {
+        m_data = std::move(d);
+        m_storage = storage::boxed;
+    }
+}
+
+std::string sqf::runtime::value::to_string_inline() const
+{
+    switch (m_storage)
+    {
+    case storage::scalar: return sqf::types::d_scalar(m_scalar).to_string();
+    case storage::boolean: return sqf::types::d_boolean(m_boolean).to_string();
+    default: return {};
+    }
+}
+
+std::string sqf::runtime::value::to_string_sqf_inline() const
+{
+    switch (m_storage)
+    {
+    case storage::scalar: return sqf::types::d_scalar(m_scalar).to_string_sqf();
+    case storage::boolean: return sqf::types::d_boolean(m_boolean).to_string_sqf();
+    default: return {};
+    }
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "data.h"
+#include "scalar.h"
 
 #include <string>
 #include <optional>
@@ -15,23 +16,100 @@ namespace sqf
     {
         template<typename T>
         inline std::shared_ptr<sqf::runtime::data> to_data(T t);
+        class d_scalar;
+        class d_boolean;
     }
     namespace runtime
     {
+        // SCALAR and BOOL are declared alongside value, as value stores them inline.
+        struct t_scalar : public type::extend<t_scalar> { t_scalar() : extend() {} static const std::string name() { return "SCALAR"; } };
+        struct t_boolean : public type::extend<t_boolean> { t_boolean() : extend() {} static const std::string name() { return "BOOL"; } };
+
         class value
         {
         public:
             using cwref = std::reference_wrapper<const value>;
             using cref = const value&;
         private:
+            /// <summary>
+            /// Describes where the contents of a value are located.
+            /// SCALAR and BOOL are held inline, everything else is boxed into m_data.
+            /// </summary>
+            enum class storage : unsigned char
+            {
+                nil,
+                scalar,
+                boolean,
+                boxed
+            };
             std::shared_ptr<sqf::runtime::data> m_data;
+            union
+            {
+                sqf::runtime::scalar_t m_scalar;
+                bool m_boolean;
+            };
+            storage m_storage;
+
+            /// <summary>
+            /// Creates a new sqf::runtime::data instance out of an inline stored value.
+            /// </summary>
+            std::shared_ptr<sqf::runtime::data> box() const;
+            /// <summary>
+            /// Takes over a data instance of unknown type, unboxing it if possible.
+            /// </summary>
+            void adopt(std::shared_ptr<sqf::runtime::data> d);
+            std::string to_string_inline() const;
+            std::string to_string_sqf_inline() const;
+            bool is_inline() const { return m_storage == storage::scalar || m_storage == storage::boolean; }
         public:
-            constexpr value() noexcept {}
+            constexpr value() noexcept : m_scalar(0), m_storage(storage::nil) {}
 
             template<typename T>
-            value(T t) : m_data(::sqf::types::to_data<T>(t)) { }
+            value(T t) : m_scalar(0), m_storage(storage::nil)
+            {
+                if constexpr (std::is_same<T, bool>::value)
+                {
+                    m_boolean = t;
+                    m_storage = storage::boolean;
+                }
+                else if constexpr (std::is_arithmetic<T>::value && !std::is_same<T, char>::value)
+                {
+                    m_scalar = (sqf::runtime::scalar_t)t;
+                    m_storage = storage::scalar;
+                }
+                else
+                {
+                    m_data = ::sqf::types::to_data<T>(t);
+                    m_storage = m_data ? storage::boxed : storage::nil;
+                }
+            }
             template<typename T>
-            value(std::shared_ptr<T> d) : m_data(std::move(d)) { }
+            value(std::shared_ptr<T> d) : m_scalar(0), m_storage(storage::nil)
+            {
+                if (!d)
+                {
+                    return;
+                }
+                if constexpr (std::is_same<T, ::sqf::types::d_scalar>::value)
+                {
+                    m_scalar = d->value();
+                    m_storage = storage::scalar;
+                }
+                else if constexpr (std::is_same<T, ::sqf::types::d_boolean>::value)
+                {
+                    m_boolean = d->value();
+                    m_storage = storage::boolean;
+                }
+                else if constexpr (std::is_same<T, sqf::runtime::data>::value)
+                {
+                    adopt(std::move(d));
+                }
+                else
+                {
+                    m_data = std::move(d);
+                    m_storage = storage::boxed;
+                }
+            }
 
             template<class T>
             bool is() const
@@ -43,23 +121,66 @@ namespace sqf
             {
                 return this->operator sqf::runtime::type() == t;
             }
-            bool empty() const { return !m_data.get(); }
+            bool empty() const { return m_storage == storage::nil; }
 
-            bool operator==(cref other) const { return (((bool)m_data.get()) && ((bool)other.m_data.get()) && m_data->equals(other.m_data)) || (!((bool)m_data.get()) && !((bool)other.m_data.get())); }
+            bool operator==(cref other) const
+            {
+                if (m_storage != other.m_storage) { return false; }
+                switch (m_storage)
+                {
+                case storage::nil: return true;
+                case storage::scalar: return m_scalar == other.m_scalar;
+                case storage::boolean: return m_boolean == other.m_boolean;
+                default: return m_data->equals(other.m_data);
+                }
+            }
             bool operator!=(cref other) const { return !(*this == other); }
 
+            /// <summary>
+            /// Compares this value against the other value and returns
+            /// true if they are equivalent.
+            /// Values of different type or nil values never are equal.
+            /// </summary>
+            /// <param name="other">The other value</param>
+            /// <param name="invariant">Wether operation should be case sensitive (false) or not (true)</param>
+            /// <returns>The result of the comparison</returns>
+            bool equals(cref other, bool invariant = false) const
+            {
+                if (m_storage != other.m_storage) { return false; }
+                switch (m_storage)
+                {
+                case storage::nil: return false;
+                case storage::scalar: return m_scalar == other.m_scalar;
+                case storage::boolean: return m_boolean == other.m_boolean;
+                default: return m_data->equals(other.m_data, invariant);
+                }
+            }
+
 
             /// <summary>
             /// Returns the m_data member.
             /// </summary>
+            /// <remarks>
+            /// Inline stored values (SCALAR, BOOL) get boxed into a new instance on every call.
+            /// Modifying that instance will not change this value.
+            /// </remarks>
             /// <returns></returns>
-            std::shared_ptr<sqf::runtime::data> data() const { return m_data; }
+            std::shared_ptr<sqf::runtime::data> data() const { return m_storage == storage::boxed ? m_data : is_inline() ? box() : std::shared_ptr<sqf::runtime::data>(); }
 
-            std::string to_string_sqf() const { return m_data ? m_data->to_string_sqf() : std::string("nil"); }
-            std::string to_string() const { return m_data ? m_data->to_string() : std::string(); }
+            std::string to_string_sqf() const { return m_storage == storage::boxed ? m_data->to_string_sqf() : is_inline() ? to_string_sqf_inline() : std::string("nil"); }
+            std::string to_string() const { return m_storage == storage::boxed ? m_data->to_string() : is_inline() ? to_string_inline() : std::string(); }
 
-            explicit operator sqf::runtime::type() const { return m_data ? m_data->type() : sqf::types::t_nothing(); };
-            sqf::runtime::type type() const { return m_data ? m_data->type() : sqf::types::t_nothing(); }
+            explicit operator sqf::runtime::type() const { return type(); };
+            sqf::runtime::type type() const
+            {
+                switch (m_storage)
+                {
+                case storage::scalar: return t_scalar();
+                case storage::boolean: return t_boolean();
+                case storage::boxed: return m_data->type();
+                default: return sqf::types::t_nothing();
+                }
+            }
 
             /// <summary>
             /// Attempts to convert the data-member to the provided data type.
@@ -73,32 +194,45 @@ namespace sqf
             template <class T>
             std::shared_ptr<T> data_try() const {
                 static_assert(std::is_base_of<sqf::runtime::data, T>::value, "value::data_try_as<T>() can only convert to sqf::runtime::data types");
-                return std::dynamic_pointer_cast<T>(m_data);
-            }
-            template <class T, typename TValue>
-            std::optional<TValue> data_try() const {
-                auto conv = data_try<T>();
-                if (conv)
+                if constexpr (std::is_same<T, ::sqf::types::d_scalar>::value || std::is_same<T, ::sqf::types::d_boolean>::value || std::is_same<T, sqf::runtime::data>::value)
                 {
-                    return (TValue)*conv;
+                    return std::dynamic_pointer_cast<T>(data());
                 }
                 else
                 {
-                    return {};
+                    return std::dynamic_pointer_cast<T>(m_data);
                 }
             }
             template <class T, typename TValue>
-            TValue data_try(TValue def) const {
-                auto conv = data_try<T>();
-                if (conv)
+            std::optional<TValue> data_try() const {
+                if constexpr (std::is_same<T, ::sqf::types::d_scalar>::value)
                 {
-                    return (TValue)*conv;
+                    if (m_storage == storage::scalar) { return (TValue)m_scalar; }
+                    return {};
+                }
+                else if constexpr (std::is_same<T, ::sqf::types::d_boolean>::value)
+                {
+                    if (m_storage == storage::boolean) { return (TValue)m_boolean; }
+                    return {};
                 }
                 else
                 {
-                    return def;
+                    auto conv = data_try<T>();
+                    if (conv)
+                    {
+                        return (TValue)*conv;
+                    }
+                    else
+                    {
+                        return {};
+                    }
                 }
             }
+            template <class T, typename TValue>
+            TValue data_try(TValue def) const {
+                auto conv = data_try<T, TValue>();
+                return conv.has_value() ? *conv : def;
+            }
             /// <summary>
             /// Converts the data-member to the provided data type.
             /// Will use std::static_pointer_cast.
@@ -111,15 +245,32 @@ namespace sqf
             template<class T>
             std::shared_ptr<T> data() const {
                 static_assert(std::is_base_of<sqf::runtime::data, T>::value, "value::data<T>() can only convert to sqf::runtime::data types");
-                return std::static_pointer_cast<T>(m_data);
+                return std::static_pointer_cast<T>(m_storage == storage::boxed ? m_data : data());
             }
 
             template<class TData, typename TValue>
-            TValue data() const { return (TValue)(*data<TData>()); }
+            TValue data() const
+            {
+                if constexpr (std::is_same<TData, ::sqf::types::d_scalar>::value)
+                {
+                    if (m_storage == storage::scalar) { return (TValue)m_scalar; }
+                }
+                else if constexpr (std::is_same<TData, ::sqf::types::d_boolean>::value)
+                {
+                    if (m_storage == storage::boolean) { return (TValue)m_boolean; }
+                }
+                return (TValue)(*data<TData>());
+            }
 
             std::size_t hash() const
             {
-                return empty() ? 0 : m_data->hash();
+                switch (m_storage)
+                {
+                case storage::scalar: return std::hash<sqf::runtime::scalar_t>()(m_scalar);
+                case storage::boolean: return std::hash<bool>()(m_boolean);
+                case storage::boxed: return m_data->hash();
+                default: return 0;
+                }
             }
         };
     }
@@ -1,11 +1,14 @@
 #pragma once
 #include "value.h"
+#include "symbol.h"
+#include "local_layout.h"
 
 #include <unordered_map>
 #include <string>
 #include <string_view>
 #include <optional>
-#include <cctype>
+#include <vector>
+#include <memory>
 #include <algorithm>
 
 #ifdef DF__SQF_RUNTIME__VALUE_SCOPE_DEBUG
@@ -18,55 +21,164 @@ namespace sqf::runtime
     {
     private:
         std::string m_scope_name;
-        std::unordered_map<std::string, sqf::runtime::value> m_map;
+        std::unordered_map<sqf::runtime::symbol, sqf::runtime::value> m_map;
+        std::shared_ptr<const sqf::runtime::local_layout> m_layout;
+        std::vector<std::optional<sqf::runtime::value>> m_slots;
+
+        size_t slot_of(const sqf::runtime::symbol& variable) const
+        {
+            return m_layout ? m_layout->index_of(variable) : sqf::runtime::local_layout::npos;
+        }
     public:
         value_scope() = default;
 
-        sqf::runtime::value operator[](const std::string& index) const { return at(index); }
-        sqf::runtime::value& operator[](const std::string& index) { return at(index); }
+        sqf::runtime::value operator[](const sqf::runtime::symbol& index) const { return at(index); }
+        sqf::runtime::value& operator[](const sqf::runtime::symbol& index) { return at(index); }
+        sqf::runtime::value operator[](std::string_view index) const { return at(index); }
+        sqf::runtime::value& operator[](std::string_view index) { return at(index); }
 
-        bool contains(std::string variable_name) const
+        bool contains(const sqf::runtime::symbol& variable) const
         {
-            std::transform(variable_name.begin(), variable_name.end(), variable_name.begin(), [](char& c) { return (char)std::tolower((int)c); });
-            auto res = m_map.find(variable_name) != m_map.end();
+            auto res = find(variable) != nullptr;
 #ifdef DF__SQF_RUNTIME__VALUE_SCOPE_DEBUG
             std::cout << "\x1B[33m[VALUE-SCOPE-DBG]\033[0m" <<
                 "        " <<
                 "        " <<
-                "    " << "    " << "contains(\"" << variable_name << "\") const := " << res << std::endl;
+                "    " << "    " << "contains(\"" << variable.name() << "\") const := " << res << std::endl;
 #endif // DF__SQF_RUNTIME__VALUE_SCOPE_DEBUG
             return res;
         }
-        sqf::runtime::value at(std::string variable_name) const
+        bool contains(std::string_view variable_name) const { return contains(sqf::runtime::symbol::transient(variable_name)); }
+
+        /// <summary>
+        /// Receives a pointer to the value of the provided variable.
+        /// </summary>
+        /// <returns>The value or nullptr if the variable is not part of this scope.</returns>
+        const sqf::runtime::value* find(const sqf::runtime::symbol& variable) const
         {
-            std::transform(variable_name.begin(), variable_name.end(), variable_name.begin(), [](char& c) { return (char)std::tolower((int)c); });
-            auto res = m_map.find(variable_name);
+            const sqf::runtime::value* res = nullptr;
+            auto slot = slot_of(variable);
+            if (slot != sqf::runtime::local_layout::npos)
+            {
+                res = slot < m_slots.size() && m_slots[slot].has_value() ? &*m_slots[slot] : nullptr;
+            }
+            else
+            {
+                auto it = m_map.find(variable);
+                res = it == m_map.end() ? nullptr : &it->second;
+            }
 #ifdef DF__SQF_RUNTIME__VALUE_SCOPE_DEBUG
             std::cout << "\x1B[33m[VALUE-SCOPE-DBG]\033[0m" <<
                 "        " <<
                 "        " <<
-                "    " << "    " << "at(\"" << variable_name << "\") const := { " << (res == m_map.end() ? "" : res->second.to_string_sqf()) << " }" << std::endl;
+                "    " << "    " << "find(\"" << variable.name() << "\") const := { " << (res ? res->to_string_sqf() : "") << " }" << std::endl;
 #endif // DF__SQF_RUNTIME__VALUE_SCOPE_DEBUG
-            return res == m_map.end() ? value() : res->second;
+            return res;
+        }
+        sqf::runtime::value* find(const sqf::runtime::symbol& variable)
+        {
+            return const_cast<sqf::runtime::value*>(static_cast<const value_scope*>(this)->find(variable));
+        }
+
+        sqf::runtime::value at(const sqf::runtime::symbol& variable) const
+        {
+            auto res = find(variable);
+            return res ? *res : value();
         }
-        sqf::runtime::value& at(std::string variable_name)
+        sqf::runtime::value at(std::string_view variable_name) const { return at(sqf::runtime::symbol::transient(variable_name)); }
+        sqf::runtime::value& at(const sqf::runtime::symbol& variable)
         {
-            std::transform(variable_name.begin(), variable_name.end(), variable_name.begin(), [](char& c) { return (char)std::tolower((int)c); });
 #ifdef DF__SQF_RUNTIME__VALUE_SCOPE_DEBUG
-            auto res = m_map.find(variable_name);
+            auto res = find(variable);
             std::cout << "\x1B[33m[VALUE-SCOPE-DBG]\033[0m" <<
                 "        " <<
                 "        " <<
-                "    " << "    " << "at(\"" << variable_name << "\") := { " << (res == m_map.end() ? "" : res->second.to_string_sqf()) << " }" << std::endl;
+                "    " << "    " << "at(\"" << variable.name() << "\") := { " << (res ? res->to_string_sqf() : "") << " }" << std::endl;
 #endif // DF__SQF_RUNTIME__VALUE_SCOPE_DEBUG
-            return m_map[variable_name];
+            auto slot = slot_of(variable);
+            if (slot != sqf::runtime::local_layout::npos)
+            {
+                return slot_at(slot);
+            }
+            return m_map[variable];
         }
+        sqf::runtime::value& at(std::string_view variable_name) { return at(sqf::runtime::symbol::transient(variable_name)); }
         std::string_view scope_name() const { return m_scope_name; }
         void scope_name(std::string value) { m_scope_name = value; }
-        void clear_value_scope() { m_map.clear(); }
-        std::optional<sqf::runtime::value> try_get(std::string variable_name) { if (contains(variable_name)) { return at(variable_name); } return {}; }
+        void clear_value_scope()
+        {
+            m_map.clear();
+            for (auto& it : m_slots) { it.reset(); }
+        }
+        std::optional<sqf::runtime::value> try_get(const sqf::runtime::symbol& variable) const { auto res = find(variable); if (res) { return *res; } return {}; }
+        std::optional<sqf::runtime::value> try_get(std::string_view variable_name) const { return try_get(sqf::runtime::symbol::transient(variable_name)); }
 
-        std::unordered_map<std::string, sqf::runtime::value>::iterator begin() { return m_map.begin(); }
-        std::unordered_map<std::string, sqf::runtime::value>::iterator end() { return m_map.end(); }
+        /// <summary>
+        /// The slot layout currently used by this scope or nullptr if all variables are kept in the map.
+        /// </summary>
+        const sqf::runtime::local_layout* layout() const { return m_layout.get(); }
+
+        /// <summary>
+        /// Changes the slot layout of this scope.
+        /// Variables already set are moved between slots and map as required by the new layout.
+        /// Slots are allocated on first write, keeping scopes that never assign a variable free of allocations.
+        /// </summary>
+        void layout(std::shared_ptr<const sqf::runtime::local_layout> layout)
+        {
+            if (layout == m_layout) { return; }
+            for (size_t i = 0; i < m_slots.size(); i++)
+            {
+                if (m_slots[i].has_value())
+                {
+                    m_map[m_layout->at(i)] = std::move(*m_slots[i]);
+                }
+            }
+            m_slots.clear();
+            m_layout = std::move(layout);
+            if (!m_layout || m_map.empty()) { return; }
+            for (size_t i = 0; i < m_layout->size(); i++)
+            {
+                auto it = m_map.find(m_layout->at(i));
+                if (it != m_map.end())
+                {
+                    slot_at(i) = std::move(it->second);
+                    m_map.erase(it);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Receives the value stored in the provided slot of the current layout.
+        /// </summary>
+        /// <returns>The value or nullptr if the variable was not set yet.</returns>
+        sqf::runtime::value* slot(size_t slot) { return slot < m_slots.size() && m_slots[slot].has_value() ? &*m_slots[slot] : nullptr; }
+
+        /// <summary>
+        /// Receives the value stored in the provided slot of the current layout, setting it to nil if not set yet.
+        /// </summary>
+        sqf::runtime::value& slot_at(size_t slot)
+        {
+            if (slot >= m_slots.size()) { m_slots.resize(m_layout->size()); }
+            auto& res = m_slots[slot];
+            if (!res.has_value()) { res.emplace(); }
+            return *res;
+        }
+
+        /// <summary>
+        /// Receives all variables currently set in this scope, ordered by name.
+        /// </summary>
+        std::vector<std::pair<sqf::runtime::symbol, sqf::runtime::value>> variables() const
+        {
+            std::vector<std::pair<sqf::runtime::symbol, sqf::runtime::value>> res(m_map.begin(), m_map.end());
+            for (size_t i = 0; i < m_slots.size(); i++)
+            {
+                if (m_slots[i].has_value())
+                {
+                    res.emplace_back(m_layout->at(i), *m_slots[i]);
+                }
+            }
+            std::sort(res.begin(), res.end(), [](const auto& l, const auto& r) { return l.first.name() < r.first.name(); });
+            return res;
+        }
     };
 }
\ No newline at end of file
@@ -1,15 +1,16 @@
 #pragma once
+#include "scalar.h"
 
 namespace sqf::runtime
 {
     struct vec3
     {
-        float x;
-        float y;
-        float z;
+        scalar_t x;
+        scalar_t y;
+        scalar_t z;
 
         vec3() : x(0), y(0), z(0) {}
-        vec3(float x, float y, float z) : x(x), y(y), z(z) {}
-        vec3(float x, float y) : x(x), y(y), z(0) {}
+        vec3(scalar_t x, scalar_t y, scalar_t z) : x(x), y(y), z(z) {}
+        vec3(scalar_t x, scalar_t y) : x(x), y(y), z(0) {}
     };
 }
\ No newline at end of file
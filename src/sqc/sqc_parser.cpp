@@ -11,6 +11,7 @@
 #include "../runtime/d_code.h"
 #include <algorithm>
 #include <charconv>
+#include <limits>
 #include <sstream>
 #include <functional>
 
@@ -113,10 +114,10 @@ namespace sqf::sqc::util
         std::vector<::sqf::runtime::instruction::sptr> inner;
         std::vector<region_impl> m_regions;
         std::vector<::sqf::sqc::bison::astkind> m_parents;
-        std::string_view m_contents;
-        setbuilder(std::string_view contents, std::vector<::sqf::sqc::bison::astkind> m_parents) : m_parents(m_parents), m_contents(contents) {}
+        std::shared_ptr<::sqf::runtime::diagnostics::source_table> m_sources;
+        setbuilder(std::shared_ptr<::sqf::runtime::diagnostics::source_table> sources, std::vector<::sqf::sqc::bison::astkind> m_parents) : m_parents(m_parents), m_sources(sources) {}
     public:
-        setbuilder(std::string_view contents) : m_contents(contents) {}
+        setbuilder(std::string_view contents) : m_sources(std::make_shared<::sqf::runtime::diagnostics::source_table>(std::string(contents))) {}
 
         std::vector<::sqf::runtime::instruction::sptr>& instructions()
         {
@@ -125,11 +126,11 @@ namespace sqf::sqc::util
 
         setbuilder create_from() const
         {
-            return { m_contents, m_parents };
+            return { m_sources, m_parents };
         }
         void push_back(const ::sqf::sqc::tokenizer::token& t, ::sqf::runtime::instruction::sptr ptr, position pos = current)
         {
-            ptr->diag_info({ t.line, t.column, t.offset, { t.path, {} }, ::sqf::runtime::parser::sqf::create_code_segment(m_contents, t.offset, t.contents.length()) });
+            ptr->diag_info(m_sources->create(t.line, t.column, t.offset, t.contents.length(), t.path));
             if (m_regions.empty())
             {
                 inner.push_back(ptr);
@@ -141,7 +142,7 @@ namespace sqf::sqc::util
         }
         void push_back(const ::sqf::sqc::tokenizer::token& t, size_t custom_length, ::sqf::runtime::instruction::sptr ptr, position pos = current)
         {
-            ptr->diag_info({ t.line, t.column, t.offset, { t.path, {} }, ::sqf::runtime::parser::sqf::create_code_segment(m_contents, t.offset, custom_length) });
+            ptr->diag_info(m_sources->create(t.line, t.column, t.offset, custom_length, t.path));
             if (m_regions.empty())
             {
                 inner.push_back(ptr);
@@ -1523,7 +1524,7 @@ void sqf::sqc::parser::to_assembly(::sqf::runtime::runtime& runtime, util::setbu
         catch (std::out_of_range&)
         {
             log(logmessage::assembly::NumberOutOfRange({}));
-            set.push_back(node.token, std::make_shared<::sqf::opcodes::push>(::sqf::runtime::value(std::make_shared<::sqf::types::d_scalar>(std::nanf("")))));
+            set.push_back(node.token, std::make_shared<::sqf::opcodes::push>(::sqf::runtime::value(std::make_shared<::sqf::types::d_scalar>(std::numeric_limits<::sqf::runtime::scalar_t>::quiet_NaN()))));
         }
         // We cannot use "modern" variant due to lack of GCC support in GitHub Actions as of 29.08.2020
         // auto result = std::from_chars(node.token.contents.data(), node.token.contents.data() + node.token.contents.size(), d);
@@ -2236,7 +2237,7 @@ static void to_sqc_actual(std::stringstream& out_sstream, source_type type, ::sq
                 }
                 else
                 {
-                    sstream << push->value().data<::sqf::runtime::data>()->to_string_sqf();
+                    sstream << push->value().to_string_sqf();
                 }
             });
         }
@@ -0,0 +1,76 @@
+// Measures the throughput of the sqf, config and assembly tokenizers.
+// Usage: sqfvm_benchmark_tokenizer <sqf|config|assembly> FILE [ITERATIONS]
+// Build with -DSQFVM_BUILD_BENCHMARKS=ON.
+#include "parser/sqf/tokenizer.hpp"
+#include "parser/config/tokenizer.hpp"
+#include "parser/assembly/tokenizer.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+template<typename TTokenizer>
+static size_t tokenize(std::string& contents)
+{
+    TTokenizer t(contents.begin(), contents.end(), "benchmark");
+    size_t count = 0;
+    while (true)
+    {
+        auto token = t.next();
+        if (token.type == TTokenizer::etoken::eof || token.type == TTokenizer::etoken::invalid)
+        {
+            return count;
+        }
+        count++;
+    }
+}
+
+template<typename TTokenizer>
+static int run(std::string& contents, size_t iterations)
+{
+    size_t tokens = tokenize<TTokenizer>(contents); // warm up
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        tokens = tokenize<TTokenizer>(contents);
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double bytes = (double)contents.size() * (double)iterations;
+
+    std::cout << "size:       " << contents.size() << " bytes" << std::endl;
+    std::cout << "tokens:     " << tokens << std::endl;
+    std::cout << "iterations: " << iterations << std::endl;
+    std::cout << "time:       " << seconds << " s" << std::endl;
+    std::cout << "throughput: " << (bytes / seconds / (1024 * 1024)) << " MB/s" << std::endl;
+    std::cout << "            " << ((double)tokens * (double)iterations / seconds) << " tokens/s" << std::endl;
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <sqf|config|assembly> FILE [ITERATIONS]" << std::endl;
+        return -1;
+    }
+    std::string mode(argv[1]);
+    std::ifstream file(argv[2], std::ios::binary);
+    if (!file.good())
+    {
+        std::cerr << "Failed to open '" << argv[2] << "'." << std::endl;
+        return -1;
+    }
+    std::stringstream sstream;
+    sstream << file.rdbuf();
+    std::string contents = sstream.str();
+    size_t iterations = argc > 3 ? std::stoul(argv[3]) : 100;
+
+    if (mode == "sqf") { return run<sqf::parser::sqf::tokenizer>(contents, iterations); }
+    if (mode == "config") { return run<sqf::parser::config::tokenizer>(contents, iterations); }
+    if (mode == "assembly") { return run<sqf::parser::assembly::tokenizer>(contents, iterations); }
+    std::cerr << "Unknown tokenizer '" << mode << "'." << std::endl;
+    return -1;
+}
@@ -0,0 +1,6 @@
+#ifndef INCLUDE_GUARD_ELSE
+#define INCLUDE_GUARD_ELSE
+first
+#else
+again
+#endif
@@ -0,0 +1,4 @@
+#ifdef INCLUDE_GUARD_IFDEF
+#define INCLUDE_GUARD_IFDEF
+ifdef
+#endif
@@ -0,0 +1,4 @@
+#ifndef INCLUDE_GUARD_PLAIN
+#define INCLUDE_GUARD_PLAIN
+plain
+#endif
@@ -0,0 +1,5 @@
+#ifndef INCLUDE_GUARD_TRAILING
+#define INCLUDE_GUARD_TRAILING
+guarded
+#endif
+trailing